@@ -0,0 +1,87 @@
+/*
+  AT24eeprom - Arduino libary for driving the AT24 I2 based eeproms Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/AT24eeprom/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+
+/**
+ * Keeps a boot counter, the settings of the application and a calibration
+ * table in the eeprom. The addresses are derived from each other at compile
+ * time, and only the bytes that have changed are written.
+ */
+
+#include "Arduino.h"
+
+#include <Wire.h>
+#include "AT24CxEeprom.h"
+#include "AT24CxVar.h"
+
+static AT24C256 eeprom(Wire, 0);
+
+struct Settings {
+  uint32_t baudRate;
+  uint8_t channel;
+  int16_t offset;
+};
+
+typedef AT24CxVar<AT24C256, 0, uint32_t> BootCount;
+typedef AT24CxVarStruct<AT24C256, BootCount::END, Settings> SettingsVar;
+typedef AT24CxVarArray<AT24C256, SettingsVar::END, int16_t, 16> Calibration;
+
+static BootCount bootCount(eeprom);
+static SettingsVar settings(eeprom);
+static Calibration calibration(eeprom);
+
+static typeof(Serial)& output = Serial;
+
+//The setup function is called once at startup of the sketch
+void setup()
+{
+  output.begin(115200);
+  output.println();
+  eeprom.begin();
+
+  if(not (bootCount.load() && settings.load() && calibration.load())) {
+    output.println("Reading the eeprom failed!");
+    return;
+  }
+
+  bootCount.set(bootCount.get() + 1);
+  if(settings.get(&Settings::baudRate) != 115200) {
+    settings.set(&Settings::baudRate, 115200);
+  }
+  calibration.set(bootCount.get() % calibration.size(), static_cast<int16_t>(bootCount.get()));
+
+  // Writes only the boot counter, the baud rate if it has changed and one
+  // calibration entry.
+  if(bootCount.commit() && settings.commit() && calibration.commit()) {
+    output.print("boots: ");
+    output.println(bootCount.get());
+  } else {
+    output.println("Writing the eeprom failed!");
+  }
+}
+
+// The loop function is called in an endless loop
+void loop()
+{
+}
@@ -0,0 +1,90 @@
+/*
+  AT24eeprom - Arduino libary for driving the AT24 I2 based eeproms Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/AT24eeprom/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+
+/**
+ * Keeps a boot counter and an operating minutes counter in an eeprom region
+ * that is wear leveled by AT24CxWearLevelingRecord.
+ */
+
+#include "Arduino.h"
+
+#include <Wire.h>
+#include "AT24CxEeprom.h"
+#include "AT24CxWearLevelingRecord.h"
+
+static AT24C256 eeprom(Wire, 0);
+
+struct Counters {
+  uint32_t operatingMinutes;
+  uint32_t boots;
+};
+
+// Use 1 KByte at eeprom address 0x7C00 for the counters.
+static AT24CxWearLevelingRecord<sizeof(Counters)> record(eeprom, 0x7C00, 0x400);
+static Counters counters;
+
+static typeof(Serial)& output = Serial;
+
+static void printCounters() {
+  output.print("boots: ");
+  output.print(counters.boots);
+  output.print(", operating minutes: ");
+  output.print(counters.operatingMinutes);
+  output.print(", sequence: ");
+  output.println(record.sequence());
+}
+
+//The setup function is called once at startup of the sketch
+void setup()
+{
+  output.begin(115200);
+  output.println();
+  eeprom.begin();
+
+  if(not record.load(&counters)) {
+    output.println("No counters found, starting from zero.");
+    counters.operatingMinutes = 0;
+    counters.boots = 0;
+  }
+  ++counters.boots;
+  record.store(&counters);
+
+  output.print("Using ");
+  output.print(record.slotCount());
+  output.println(" slots.");
+  printCounters();
+}
+
+// The loop function is called in an endless loop
+void loop()
+{
+  delay(60000);
+  ++counters.operatingMinutes;
+  if(record.store(&counters)) {
+    printCounters();
+  } else {
+    output.println("Storing the counters failed!");
+  }
+}
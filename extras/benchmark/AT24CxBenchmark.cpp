@@ -0,0 +1,209 @@
+/*
+  AT24eeprom - Arduino libary for driving the AT24 I2 based eeproms Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/AT24eeprom/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+/*
+  Host-side benchmark of the AT24CxEeprom library. The library sources are
+  linked against the simulated Arduino core and TwoWire driver in this
+  directory, which charge every bus transfer and every write cycle to a
+  virtual clock. See README.md for how to build and run it.
+
+  For each chip class and bus clock, the standard workloads are run on a
+  fresh simulated device and checked against the simulated memory array.
+  The benchmark exits with a non-zero status if a workload fails.
+*/
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <stdlib.h>
+#include <vector>
+
+#include "AT24CxSim.h"
+#include "AT24CxEeprom.h"
+
+namespace { // anonymous
+
+// Workload sizes. They are the same for all chips, so the results of the
+// chip classes can be compared.
+constexpr size_t DUMP_READ_SIZE = 256;
+constexpr size_t RANDOM_READS = 1000;
+constexpr size_t RANDOM_READ_SIZE = 4;
+constexpr size_t SCATTERED_UPDATES = 200;
+constexpr size_t SCATTERED_UPDATE_SIZE = 8;
+
+// Deterministic pseudo random numbers, so that every run issues the same
+// transfers.
+class XorShift32 {
+public:
+	XorShift32(const uint32_t seed) : mState(seed) {}
+	uint32_t next() {
+		mState ^= mState << 13;
+		mState ^= mState >> 17;
+		mState ^= mState << 5;
+		return mState;
+	}
+private:
+	uint32_t mState;
+};
+
+struct Result {
+	uint64_t micros;
+	AT24CxSim::Counters counters;
+	bool success;
+};
+
+class Benchmark {
+public:
+	Benchmark(AT24CxEeprom& eeprom, AT24CxSim::Device& device)
+		: mEeprom(eeprom), mDevice(device), mSize(eeprom.totalSize()) {
+	}
+
+	Result sequentialDump() {
+		start();
+		std::vector<uint8_t> buffer(DUMP_READ_SIZE);
+		bool success = true;
+		for (uint32_t address = 0; address < mSize && success; address += DUMP_READ_SIZE) {
+			success = mEeprom.read(address, buffer.data(), DUMP_READ_SIZE)
+				&& memcmp(buffer.data(), &mDevice.memory()[address], DUMP_READ_SIZE) == 0;
+		}
+		return stop(success);
+	}
+
+	Result randomSmallReads() {
+		XorShift32 random(0x1234567);
+		start();
+		bool success = true;
+		for (size_t i = 0; i < RANDOM_READS && success; i++) {
+			const uint32_t address = random.next() % (mSize - RANDOM_READ_SIZE);
+			uint8_t bytes[RANDOM_READ_SIZE];
+			success = mEeprom.read(address, bytes, RANDOM_READ_SIZE)
+				&& memcmp(bytes, &mDevice.memory()[address], RANDOM_READ_SIZE) == 0;
+		}
+		return stop(success);
+	}
+
+	Result scatteredUpdates() {
+		XorShift32 random(0x89ABCDE);
+		start();
+		bool success = true;
+		for (size_t i = 0; i < SCATTERED_UPDATES && success; i++) {
+			const uint32_t address = random.next() % (mSize - SCATTERED_UPDATE_SIZE);
+			uint8_t bytes[SCATTERED_UPDATE_SIZE];
+			for (size_t j = 0; j < SCATTERED_UPDATE_SIZE; j++) {
+				bytes[j] = static_cast<uint8_t>(random.next());
+			}
+			success = mEeprom.write(address, bytes, SCATTERED_UPDATE_SIZE)
+				&& memcmp(bytes, &mDevice.memory()[address], SCATTERED_UPDATE_SIZE) == 0;
+		}
+		return stop(success);
+	}
+
+	Result fullDeviceWrite() {
+		std::vector<uint8_t> image(mSize);
+		for (uint32_t i = 0; i < mSize; i++) {
+			image[i] = static_cast<uint8_t>((i * 7) ^ (i >> 8));
+		}
+		start();
+		bool success = mEeprom.write(0, image.data(), mSize);
+		Result result = stop(success);
+		result.success = result.success && memcmp(image.data(), mDevice.memory(), mSize) == 0;
+		return result;
+	}
+
+private:
+	AT24CxEeprom& mEeprom;
+	AT24CxSim::Device& mDevice;
+	const uint32_t mSize;
+	uint64_t mStart = 0;
+
+	void start() {
+		// Let a pending write cycle complete, so that it is not charged to
+		// the workload.
+		delay(20);
+		AT24CxSim::reset();
+		mStart = AT24CxSim::now();
+	}
+
+	Result stop(const bool success) {
+		Result result;
+		result.micros = AT24CxSim::now() - mStart;
+		result.counters = AT24CxSim::bus();
+		result.success = success;
+		return result;
+	}
+};
+
+void printHeader() {
+	printf("# BUFFER_LENGTH=%u\n", static_cast<unsigned>(BUFFER_LENGTH));
+	printf("%-9s %7s  %-20s %12s %12s %10s %13s %12s\n", "chip", "clock", "workload",
+		"sim time ms", "payload", "bus bytes", "bus/payload", "write cycles");
+}
+
+bool printResult(const char* chip, const uint32_t clock, const char* workload, const Result& result) {
+	const AT24CxSim::Counters& c = result.counters;
+	const double ratio = c.payloadBytes > 0 ? static_cast<double>(c.busBytes) / c.payloadBytes : 0.0;
+	printf("%-9s %4lukHz  %-20s %12.1f %12llu %10llu %13.3f %12llu%s\n", chip,
+		static_cast<unsigned long>(clock / 1000), workload, result.micros / 1000.0,
+		static_cast<unsigned long long>(c.payloadBytes), static_cast<unsigned long long>(c.busBytes),
+		ratio, static_cast<unsigned long long>(c.writeCycles), result.success ? "" : "  FAILED");
+	return result.success;
+}
+
+template<typename CHIP>
+bool run(const AT24CxSim::Geometry& geometry, const uint32_t clock) {
+	AT24CxSim::detachAll();
+	AT24CxSim::Device device(geometry, 0);
+	AT24CxSim::attach(device);
+
+	CHIP eeprom(Wire, 0);
+	eeprom.begin(static_cast<AT24CxEeprom::CLOCK_SPEED_HZ>(clock));
+	Benchmark benchmark(eeprom, device);
+
+	// The full device write runs first, so that the reads return a known
+	// pattern instead of the erased state.
+	bool success = printResult(geometry.name, clock, "full device write", benchmark.fullDeviceWrite());
+	success = printResult(geometry.name, clock, "sequential dump", benchmark.sequentialDump()) && success;
+	success = printResult(geometry.name, clock, "random small reads", benchmark.randomSmallReads()) && success;
+	success = printResult(geometry.name, clock, "scattered updates", benchmark.scatteredUpdates()) && success;
+	return success;
+}
+
+} // anonymous namespace
+
+int main() {
+	static const uint32_t clocks[] = {
+		AT24CxEeprom::CLK_STANDARD_SPEED, AT24CxEeprom::CLK_HIGH_SPEED, AT24CxEeprom::CLK_FAST_PLUS
+	};
+
+	printHeader();
+	bool success = true;
+	for (const uint32_t clock : clocks) {
+		success = run<AT24C02>(AT24CxSim::AT24C02, clock) && success;
+		success = run<AT24C16>(AT24CxSim::AT24C16, clock) && success;
+		success = run<AT24C64>(AT24CxSim::AT24C64, clock) && success;
+		success = run<AT24C256>(AT24CxSim::AT24C256, clock) && success;
+		success = run<AT24C512>(AT24CxSim::AT24C512, clock) && success;
+		success = run<AT24CM02>(AT24CxSim::AT24CM02, clock) && success;
+	}
+	return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
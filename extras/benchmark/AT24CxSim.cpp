@@ -0,0 +1,307 @@
+/*
+  AT24eeprom - Arduino libary for driving the AT24 I2 based eeproms Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/AT24eeprom/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+/*
+  Cycle-approximate model of AT24C serial EEPROMs on a simulated I2C bus.
+*/
+
+#include "AT24CxSim.h"
+
+#include "Arduino.h"
+#include "Wire.h"
+
+HostSerial Serial;
+TwoWire Wire;
+
+namespace AT24CxSim {
+
+const Geometry AT24C01  = {"AT24C01",  0x80,    8,   1, 5000};
+const Geometry AT24C02  = {"AT24C02",  0x100,   8,   1, 5000};
+const Geometry AT24C04  = {"AT24C04",  0x200,   16,  1, 5000};
+const Geometry AT24C08  = {"AT24C08",  0x400,   16,  1, 5000};
+const Geometry AT24C16  = {"AT24C16",  0x800,   16,  1, 5000};
+const Geometry AT24C32  = {"AT24C32",  0x1000,  32,  2, 5000};
+const Geometry AT24C64  = {"AT24C64",  0x2000,  32,  2, 5000};
+const Geometry AT24C128 = {"AT24C128", 0x4000,  64,  2, 5000};
+const Geometry AT24C256 = {"AT24C256", 0x8000,  64,  2, 5000};
+const Geometry AT24C512 = {"AT24C512", 0x10000, 128, 2, 5000};
+const Geometry AT24CM01 = {"AT24CM01", 0x20000, 256, 2, 5000};
+const Geometry AT24CM02 = {"AT24CM02", 0x40000, 256, 2, 10000};
+
+namespace {
+
+uint64_t simTime = 0;
+Counters busCounters;
+std::vector<Device*> devices;
+
+uint8_t blockMask(const Geometry& g) {
+	const uint32_t directlyAddressable = 1UL << (8 * g.addressBytes);
+	uint8_t mask = 0;
+	for (uint32_t size = directlyAddressable; size < g.totalSize; size <<= 1) {
+		mask = (mask << 1) | 1;
+	}
+	return mask;
+}
+
+Device* find(uint8_t busAddress) {
+	for (Device* device : devices) {
+		if (device->matches(busAddress)) {
+			return device;
+		}
+	}
+	return nullptr;
+}
+
+// Charge the bus time for the given number of bit periods.
+void clockBits(uint32_t clock, uint64_t bits) {
+	advance((bits * 1000000ULL + clock - 1) / clock);
+}
+
+} // anonymous namespace
+
+uint64_t now() {
+	return simTime;
+}
+
+void advance(uint64_t micros) {
+	simTime += micros;
+}
+
+Counters& bus() {
+	return busCounters;
+}
+
+void attach(Device& device) {
+	devices.push_back(&device);
+}
+
+void detachAll() {
+	devices.clear();
+}
+
+void reset() {
+	busCounters.clear();
+	for (Device* device : devices) {
+		device->counters.clear();
+	}
+}
+
+Device::Device(const Geometry& geometry, uint8_t pins, uint32_t writeCycleMicros, uint32_t maxClockHz)
+		: writeCycleMicros(writeCycleMicros > 0 ? writeCycleMicros : geometry.writeCycleMicros), maxClockHz(maxClockHz), counters(), mGeometry(geometry),
+		  mPins(pins & 0x07), mMemory(geometry.totalSize, 0xFF), mPageLatch(geometry.pageSize),
+		  mPageLatched(geometry.pageSize), mCounter(0), mBlock(0), mReceived(0), mPageBase(0),
+		  mClockTooFast(false), mReadCount(0), mBusyUntil(0) {
+}
+
+bool Device::busy() const {
+	return simTime < mBusyUntil;
+}
+
+bool Device::matches(uint8_t busAddress) const {
+	const uint8_t mask = blockMask(mGeometry);
+	return ((busAddress & 0x78) == 0x50) && (((busAddress ^ mPins) & 0x07 & ~mask) == 0);
+}
+
+bool Device::start(uint8_t busAddress, uint32_t clock) {
+	++counters.transactions;
+	if (busy()) {
+		++counters.nacks;
+		return false;
+	}
+	mBlock = busAddress & blockMask(mGeometry);
+	mReceived = 0;
+	mClockTooFast = clock > maxClockHz;
+	mReadCount = 0;
+	for (size_t i = 0; i < mPageLatched.size(); i++) {
+		mPageLatched[i] = false;
+	}
+	return true;
+}
+
+void Device::receive(const uint8_t* bytes, size_t count) {
+	const size_t addressBytes = mGeometry.addressBytes;
+	for (size_t i = 0; i < count; i++) {
+		if (mReceived < addressBytes) {
+			const uint32_t word = (mReceived == 0) ? 0 : (mCounter & ((1UL << (8 * mReceived)) - 1));
+			const uint32_t next = (word << 8) | bytes[i];
+			++mReceived;
+			mCounter = next;
+			if (mReceived == addressBytes) {
+				mCounter = ((mBlock << (8 * addressBytes)) | next) & (mGeometry.totalSize - 1);
+				mPageBase = mCounter & ~(mGeometry.pageSize - 1);
+			}
+		} else {
+			const uint32_t offset = mCounter & (mGeometry.pageSize - 1);
+			mPageLatch[offset] = bytes[i];
+			mPageLatched[offset] = true;
+			mCounter = mPageBase | ((offset + 1) & (mGeometry.pageSize - 1));
+			++mReceived;
+			++counters.payloadBytes;
+		}
+	}
+}
+
+void Device::stop() {
+	if (mReceived > mGeometry.addressBytes) {
+		for (size_t i = 0; i < mPageLatched.size(); i++) {
+			if (mPageLatched[i]) {
+				mMemory[mPageBase + i] = mPageLatch[i];
+			}
+		}
+		mBusyUntil = simTime + writeCycleMicros;
+		++counters.writeCycles;
+	}
+	mReceived = 0;
+}
+
+uint8_t Device::transmit() {
+	uint8_t data = mMemory[mCounter];
+	mCounter = (mCounter + 1) & (mGeometry.totalSize - 1);
+	++counters.payloadBytes;
+	if (mClockTooFast && ((++mReadCount % 7) == 0)) {
+		data ^= 0x01;
+	}
+	return data;
+}
+
+} // namespace AT24CxSim
+
+// --- TwoWire
+
+using namespace AT24CxSim;
+
+TwoWire::TwoWire()
+		: mClock(100000), mTxAddress(0), mTxBuffer(), mTxLength(0), mRxBuffer(), mRxLength(0), mRxIndex(0) {
+}
+
+void TwoWire::begin() {
+}
+
+void TwoWire::setClock(uint32_t clock) {
+	mClock = clock;
+}
+
+void TwoWire::beginTransmission(uint8_t address) {
+	mTxAddress = address;
+	mTxLength = 0;
+}
+
+size_t TwoWire::write(uint8_t data) {
+	if (mTxLength >= BUFFER_LENGTH) {
+		return 0;
+	}
+	mTxBuffer[mTxLength++] = data;
+	return 1;
+}
+
+size_t TwoWire::write(const uint8_t* data, size_t quantity) {
+	for (size_t i = 0; i < quantity; i++) {
+		if (!write(data[i])) {
+			return i;
+		}
+	}
+	return quantity;
+}
+
+uint8_t TwoWire::endTransmission(uint8_t sendStop) {
+	Counters& counters = bus();
+	++counters.transactions;
+	Device* const device = find(mTxAddress);
+
+	// START + device address byte
+	clockBits(mClock, 1 + 9);
+	++counters.busBytes;
+
+	if (device == nullptr || !device->start(mTxAddress, mClock)) {
+		++counters.nacks;
+		clockBits(mClock, 1); // STOP
+		mTxLength = 0;
+		return 2;
+	}
+	clockBits(mClock, 9 * mTxLength);
+	counters.busBytes += mTxLength;
+	device->receive(mTxBuffer, mTxLength);
+	if (mTxLength > device->geometry().addressBytes) {
+		counters.payloadBytes += mTxLength - device->geometry().addressBytes;
+	}
+	if (sendStop) {
+		clockBits(mClock, 1);
+		const uint64_t cycles = device->counters.writeCycles;
+		device->stop();
+		counters.writeCycles += device->counters.writeCycles - cycles;
+	}
+	mTxLength = 0;
+	return 0;
+}
+
+uint8_t TwoWire::requestFrom(uint8_t address, uint8_t quantity, uint8_t sendStop) {
+	Counters& counters = bus();
+	++counters.transactions;
+	Device* const device = find(address);
+	mRxLength = 0;
+	mRxIndex = 0;
+
+	clockBits(mClock, 1 + 9);
+	++counters.busBytes;
+
+	if (quantity > BUFFER_LENGTH) {
+		quantity = BUFFER_LENGTH;
+	}
+
+	if (device == nullptr || device->busy()) {
+		++counters.nacks;
+		if (device) {
+			++device->counters.nacks;
+		}
+		clockBits(mClock, 1);
+		return 0;
+	}
+	++device->counters.transactions;
+	for (size_t i = 0; i < quantity; i++) {
+		mRxBuffer[i] = device->transmit();
+	}
+	mRxLength = quantity;
+	clockBits(mClock, 9 * quantity + (sendStop ? 1 : 0));
+	counters.busBytes += quantity;
+	counters.payloadBytes += quantity;
+	return quantity;
+}
+
+int TwoWire::available() {
+	return static_cast<int>(mRxLength - mRxIndex);
+}
+
+int TwoWire::read() {
+	if (mRxIndex < mRxLength) {
+		return mRxBuffer[mRxIndex++];
+	}
+	return -1;
+}
+
+int TwoWire::peek() {
+	if (mRxIndex < mRxLength) {
+		return mRxBuffer[mRxIndex];
+	}
+	return -1;
+}
@@ -0,0 +1,125 @@
+/*
+  AT24eeprom - Arduino libary for driving the AT24 I2 based eeproms Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/AT24eeprom/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+/*
+  Cycle-approximate model of AT24C serial EEPROMs on a simulated I2C bus.
+
+  Each device models its word address counter, page write buffer with roll
+  over, the self-timed write cycle (tWR) during which it does not acknowledge
+  its device address, and the block select bits that small and very large
+  parts carry in the device address byte.
+*/
+
+#pragma once
+
+#ifndef AT24Cx_SIM_H_
+#define AT24Cx_SIM_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+namespace AT24CxSim {
+
+struct Geometry {
+	const char* name;
+	uint32_t totalSize;
+	uint32_t pageSize;
+	uint8_t addressBytes;
+	uint32_t writeCycleMicros;  // maximum tWR from the datasheet
+};
+
+// Geometry of all parts supported by the library.
+extern const Geometry AT24C01;
+extern const Geometry AT24C02;
+extern const Geometry AT24C04;
+extern const Geometry AT24C08;
+extern const Geometry AT24C16;
+extern const Geometry AT24C32;
+extern const Geometry AT24C64;
+extern const Geometry AT24C128;
+extern const Geometry AT24C256;
+extern const Geometry AT24C512;
+extern const Geometry AT24CM01;
+extern const Geometry AT24CM02;
+
+struct Counters {
+	uint64_t transactions;   // START conditions
+	uint64_t busBytes;       // all bytes clocked over the bus, including device address bytes
+	uint64_t payloadBytes;   // data bytes written to or read from the memory array
+	uint64_t writeCycles;    // page programs started
+	uint64_t nacks;          // device address not acknowledged
+	void clear() {*this = Counters();}
+};
+
+class Device {
+public:
+	// A writeCycleMicros of 0 selects the tWR of the geometry.
+	Device(const Geometry& geometry, uint8_t pins /* A2..A0 */, uint32_t writeCycleMicros = 0,
+		uint32_t maxClockHz = 1000000);
+
+	const Geometry& geometry() const {return mGeometry;}
+	uint8_t* memory() {return mMemory.data();}
+	bool busy() const;
+
+	// Returns true, if the device answers to the given 7 bit bus address.
+	bool matches(uint8_t busAddress) const;
+
+	bool start(uint8_t busAddress, uint32_t clock);
+	void receive(const uint8_t* bytes, size_t count);
+	void stop();
+	uint8_t transmit();
+
+	uint32_t writeCycleMicros;
+	uint32_t maxClockHz;
+	Counters counters;
+
+private:
+	Geometry mGeometry;
+	uint8_t mPins;
+	std::vector<uint8_t> mMemory;
+	std::vector<uint8_t> mPageLatch;
+	std::vector<bool> mPageLatched;
+	uint32_t mCounter;
+	uint32_t mBlock;
+	size_t mReceived;
+	uint32_t mPageBase;
+	bool mClockTooFast;
+	uint32_t mReadCount;
+	uint64_t mBusyUntil;
+};
+
+void attach(Device& device);
+void detachAll();
+
+// Bus level counters, summed over all devices.
+Counters& bus();
+
+// Reset all counters. The simulated time keeps running, so that pending
+// write cycles are not affected.
+void reset();
+
+} // namespace AT24CxSim
+
+#endif /* AT24Cx_SIM_H_ */
@@ -0,0 +1,183 @@
+/*
+  AT24eeprom - Arduino libary for driving the AT24 I2 based eeproms Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/AT24eeprom/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+/*
+  Host-side stand-in for the parts of the Arduino core that the AT24CxEeprom
+  library uses. Time is simulated: delay(), delayMicroseconds() and every bus
+  transfer advance a virtual clock that micros() and millis() report.
+*/
+
+#pragma once
+
+#ifndef AT24Cx_SIM_ARDUINO_H_
+#define AT24Cx_SIM_ARDUINO_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdio.h>
+#include <math.h>
+
+#ifndef ARDUINO
+#define ARDUINO 10800
+#endif
+#define AT24Cx_SIM 1
+
+#define SERIAL_BUFFER_SIZE 64
+
+#define HEX 16
+#define DEC 10
+#define OCT 8
+#define BIN 2
+
+#define lowByte(w) ((uint8_t) ((w) & 0xff))
+#define highByte(w) ((uint8_t) ((w) >> 8))
+
+#define PROGMEM
+#define pgm_read_byte(addr)  (*(const uint8_t*)(addr))
+#define pgm_read_word(addr)  (*(const uint16_t*)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t*)(addr))
+
+namespace AT24CxSim {
+	uint64_t now();
+	void advance(uint64_t micros);
+}
+
+inline unsigned long micros() {return static_cast<unsigned long>(AT24CxSim::now());}
+inline unsigned long millis() {return static_cast<unsigned long>(AT24CxSim::now() / 1000);}
+inline void delay(unsigned long ms) {AT24CxSim::advance(static_cast<uint64_t>(ms) * 1000);}
+inline void delayMicroseconds(unsigned int us) {AT24CxSim::advance(us);}
+
+class Print;
+
+class Printable {
+public:
+	virtual ~Printable() {}
+	virtual size_t printTo(Print& p) const = 0;
+};
+
+class Print {
+	int write_error = 0;
+protected:
+	void setWriteError(int err = 1) {write_error = err;}
+public:
+	virtual ~Print() {}
+	int getWriteError() {return write_error;}
+	void clearWriteError() {setWriteError(0);}
+	virtual size_t write(uint8_t) = 0;
+	virtual size_t write(const uint8_t *buffer, size_t size) {
+		size_t n = 0;
+		while (size--) {
+			if (write(*buffer++)) {
+				n++;
+			} else {
+				break;
+			}
+		}
+		return n;
+	}
+	size_t write(const char *str) {
+		return str ? write(reinterpret_cast<const uint8_t*>(str), strlen(str)) : 0;
+	}
+	size_t write(const char *buffer, size_t size) {
+		return write(reinterpret_cast<const uint8_t*>(buffer), size);
+	}
+	virtual int availableForWrite() {return 0;}
+	virtual void flush() {}
+
+	size_t print(const char s[]) {return write(s);}
+	size_t print(char c) {return write(static_cast<uint8_t>(c));}
+	size_t print(unsigned char n, int base = DEC) {return print(static_cast<unsigned long>(n), base);}
+	size_t print(int n, int base = DEC) {return print(static_cast<long>(n), base);}
+	size_t print(unsigned int n, int base = DEC) {return print(static_cast<unsigned long>(n), base);}
+	size_t print(long n, int base = DEC) {
+		if (base == DEC && n < 0) {
+			return print('-') + printNumber(static_cast<unsigned long>(-n), base);
+		}
+		return printNumber(static_cast<unsigned long>(n), base);
+	}
+	size_t print(unsigned long n, int base = DEC) {return printNumber(n, base);}
+	size_t print(long long n, int base = DEC) {return print(static_cast<long>(n), base);}
+	size_t print(unsigned long long n, int base = DEC) {return printNumber(static_cast<unsigned long>(n), base);}
+	size_t print(double n, int digits = 2) {
+		char buf[48];
+		snprintf(buf, sizeof(buf), "%.*f", digits, n);
+		return write(buf);
+	}
+	size_t print(const Printable& x) {return x.printTo(*this);}
+
+	size_t println() {return write("\r\n");}
+	template<typename T> size_t println(const T& v) {size_t n = print(v); return n + println();}
+	template<typename T> size_t println(const T& v, int base) {size_t n = print(v, base); return n + println();}
+
+private:
+	size_t printNumber(unsigned long n, int base) {
+		char buf[8 * sizeof(long) + 1];
+		char *str = &buf[sizeof(buf) - 1];
+		*str = '\0';
+		if (base < 2) {
+			base = 10;
+		}
+		do {
+			const char c = n % base;
+			n /= base;
+			*--str = c < 10 ? c + '0' : c + 'A' - 10;
+		} while (n);
+		return write(str);
+	}
+};
+
+class Stream : public Print {
+public:
+	void setTimeout(unsigned long) {}
+	virtual int available() = 0;
+	virtual int read() = 0;
+	virtual int peek() = 0;
+	size_t readBytes(uint8_t* buffer, size_t length) {
+		size_t n = 0;
+		while (n < length) {
+			const int c = read();
+			if (c < 0) {
+				break;
+			}
+			buffer[n++] = static_cast<uint8_t>(c);
+		}
+		return n;
+	}
+};
+
+class HostSerial : public Stream {
+public:
+	void begin(unsigned long) {}
+	size_t write(uint8_t c) override {return fputc(c, stdout) == EOF ? 0 : 1;}
+	using Print::write;
+	int available() override {return 0;}
+	int read() override {return -1;}
+	int peek() override {return -1;}
+	operator bool() const {return true;}
+};
+
+extern HostSerial Serial;
+
+#endif /* AT24Cx_SIM_ARDUINO_H_ */
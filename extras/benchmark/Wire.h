@@ -0,0 +1,86 @@
+/*
+  AT24eeprom - Arduino libary for driving the AT24 I2 based eeproms Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/AT24eeprom/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+/*
+  Host-side stand-in for the Arduino TwoWire driver. Transfers are routed to
+  simulated AT24C devices (see AT24CxSim.h) and charged against the virtual
+  clock according to the configured bus speed.
+*/
+
+#pragma once
+
+#ifndef AT24Cx_SIM_WIRE_H_
+#define AT24Cx_SIM_WIRE_H_
+
+#include "Arduino.h"
+
+#ifndef BUFFER_LENGTH
+#define BUFFER_LENGTH 32
+#endif
+#define WIRE_HAS_END 1
+
+class TwoWire : public Stream {
+public:
+	TwoWire();
+
+	void begin();
+	void end() {}
+	void setClock(uint32_t clock);
+	uint32_t clock() const {return mClock;}
+
+	void beginTransmission(uint8_t address);
+	void beginTransmission(int address) {beginTransmission(static_cast<uint8_t>(address));}
+	uint8_t endTransmission(uint8_t sendStop);
+	uint8_t endTransmission() {return endTransmission(static_cast<uint8_t>(true));}
+
+	// Same overload set as the AVR core, so that narrowing issues show up here too.
+	uint8_t requestFrom(uint8_t address, uint8_t quantity, uint8_t sendStop);
+	uint8_t requestFrom(uint8_t address, uint8_t quantity) {return requestFrom(address, quantity, static_cast<uint8_t>(true));}
+	uint8_t requestFrom(int address, int quantity) {return requestFrom(static_cast<uint8_t>(address), static_cast<uint8_t>(quantity));}
+	uint8_t requestFrom(int address, int quantity, int sendStop) {
+		return requestFrom(static_cast<uint8_t>(address), static_cast<uint8_t>(quantity), static_cast<uint8_t>(sendStop));
+	}
+
+	size_t write(uint8_t data) override;
+	size_t write(const uint8_t* data, size_t quantity) override;
+	using Print::write;
+
+	int available() override;
+	int read() override;
+	int peek() override;
+	void flush() override {}
+
+private:
+	uint32_t mClock;
+	uint8_t mTxAddress;
+	uint8_t mTxBuffer[BUFFER_LENGTH];
+	size_t mTxLength;
+	uint8_t mRxBuffer[BUFFER_LENGTH];
+	size_t mRxLength;
+	size_t mRxIndex;
+};
+
+extern TwoWire Wire;
+
+#endif /* AT24Cx_SIM_WIRE_H_ */
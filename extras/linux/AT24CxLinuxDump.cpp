@@ -0,0 +1,95 @@
+/*
+  AT24eeprom - Arduino libary for driving the AT24 I2 based eeproms Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/AT24eeprom/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+/*
+  Hex dump of an AT24C256 on a Linux i2c-dev bus, built without the Arduino
+  core. See README.md.
+
+    at24cx_dump /dev/i2c-1 [pins]    dump the eeprom with address pins 0..7
+    at24cx_dump --fake               dump an eeprom emulated in RAM
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "AT24CxEeprom.h"
+#include "AT24CxLinuxI2cTransport.h"
+#include "AT24CxFakeTransport.h"
+
+// Prints the received bytes, 16 per line.
+class HexSink : public AT24CxEeprom::ReadSink {
+public:
+	HexSink() : mAddress(0) {}
+
+	void receive(const uint8_t byte) override {
+		if ((mAddress & 0x0F) == 0) {
+			printf("%05lx:", static_cast<unsigned long>(mAddress));
+		}
+		printf(" %02x", byte);
+		if ((++mAddress & 0x0F) == 0) {
+			printf("\n");
+		}
+	}
+
+private:
+	uint32_t mAddress;
+};
+
+static int dump(AT24CxTransport& bus, const uint8_t pins) {
+	AT24C256 eeprom(bus, pins);
+	eeprom.begin();
+
+	HexSink sink;
+	const AT24CxEeprom::Status status = eeprom.read(0, sink, eeprom.totalSize());
+	if (not status) {
+		fprintf(stderr, "read failed, status %u\n", static_cast<unsigned>(status.code()));
+		return 1;
+	}
+	return 0;
+}
+
+int main(int argc, char* argv[]) {
+	if (argc >= 2 && strcmp(argv[1], "--fake") == 0) {
+		static AT24CxFakeTransport<AT24C256> fake;
+		for (uint32_t i = 0; i < AT24C256::TOTAL_SIZE; i++) {
+			fake.memory()[i] = static_cast<uint8_t>(i);
+		}
+		return dump(fake, 0);
+	}
+
+	if (argc < 2) {
+		fprintf(stderr, "usage: %s /dev/i2c-N [pins] | --fake\n", argv[0]);
+		return 2;
+	}
+
+	AT24CxLinuxI2cTransport bus(argv[1]);
+	bus.begin();
+	if (not bus.isOpen()) {
+		fprintf(stderr, "%s: %s\n", argv[1], strerror(bus.lastErrno()));
+		return 1;
+	}
+	const uint8_t pins = (argc >= 3) ? static_cast<uint8_t>(atoi(argv[2])) : 0;
+	return dump(bus, pins);
+}
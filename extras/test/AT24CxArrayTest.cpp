@@ -0,0 +1,85 @@
+/*
+  AT24eeprom - Arduino libary for driving the AT24 I2 based eeproms Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/AT24eeprom/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+/*
+  Tests of AT24CxArray.
+*/
+
+#include <string.h>
+
+#include "AT24CxArray.h"
+#include "AT24CxTestBus.h"
+#include "AT24CxHostTest.h"
+
+AT24Cx_TEST(AT24CxArray, pagesAreStriped) {
+	static AT24CxTestBus<AT24C64> bus0(0);
+	static AT24CxTestBus<AT24C64> bus1(1);
+	AT24C64 chip0(bus0, 0);
+	AT24C64 chip1(bus1, 1);
+	AT24CxEeprom* const chips[] = {&chip0, &chip1};
+	AT24CxArray array(chips, 2);
+	utsAssert(array.totalSize() == 2 * AT24C64::TOTAL_SIZE);
+
+	uint8_t bytes[4 * AT24C64::PAGE_SIZE];
+	for (size_t i = 0; i < sizeof(bytes); i++) {
+		bytes[i] = static_cast<uint8_t>(i / AT24C64::PAGE_SIZE + 1);
+	}
+	utsAssert(array.write(0, bytes, sizeof(bytes)));
+	utsAssert(bus0.memory()[0] == 1 && bus1.memory()[0] == 2);
+	utsAssert(bus0.memory()[AT24C64::PAGE_SIZE] == 3 && bus1.memory()[AT24C64::PAGE_SIZE] == 4);
+
+	uint8_t readBack[sizeof(bytes)];
+	utsAssert(array.read(0, readBack, sizeof(readBack)));
+	utsAssert(memcmp(readBack, bytes, sizeof(bytes)) == 0);
+}
+
+AT24Cx_TEST(AT24CxArray, chipRecoversAfterFailure) {
+	static AT24CxTestBus<AT24C64> bus0(0);
+	static AT24CxTestBus<AT24C64> bus1(1);
+	AT24C64 chip0(bus0, 0);
+	AT24C64 chip1(bus1, 1);
+	AT24CxEeprom* const chips[] = {&chip0, &chip1};
+	AT24CxArray array(chips, 2);
+
+	uint8_t bytes[2 * AT24C64::PAGE_SIZE];
+	memset(bytes, 0x11, sizeof(bytes));
+	bus1.injectErrors(4, 10000);
+	utsAssert(not array.write(0, bytes, sizeof(bytes)));
+	utsAssert(bus0.memory()[0] == 0x11);
+	utsAssert(bus1.memory()[0] == 0xFF);
+
+	// Once the chip responds again, it is written again.
+	bus1.injectErrors(0, 0);
+	memset(bytes, 0x22, sizeof(bytes));
+	utsAssert(array.write(0, bytes, sizeof(bytes)));
+	utsAssert(bus0.memory()[0] == 0x22);
+	utsAssert(bus1.memory()[0] == 0x22);
+
+	// A write that only hits the other chip is not affected either.
+	bus1.injectErrors(4, 10000);
+	utsAssert(not array.write(AT24C64::PAGE_SIZE, 0x33));
+	bus1.injectErrors(0, 0);
+	utsAssert(array.write(0, 0x44));
+	utsAssert(bus0.memory()[0] == 0x44);
+}
@@ -0,0 +1,87 @@
+/*
+  AT24eeprom - Arduino libary for driving the AT24 I2 based eeproms Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/AT24eeprom/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+/*
+  Tests of the CRC engine and of AT24CxEeprom::crcRange().
+*/
+
+#include <string.h>
+
+#include "AT24CxCrc.h"
+#include "AT24CxEeprom.h"
+#include "AT24CxFakeTransport.h"
+#include "AT24CxHostTest.h"
+
+namespace { // anonymous
+
+const char CHECK_INPUT[] = "123456789";
+const size_t CHECK_LENGTH = sizeof(CHECK_INPUT) - 1;
+
+// The check values of the CRC catalogue for the input "123456789".
+const uint16_t CRC16_CHECK = 0x29B1;
+const uint32_t CRC32_CHECK = 0xCBF43926;
+
+} // anonymous namespace
+
+AT24Cx_TEST(AT24CxCrc, checkValues) {
+	const uint8_t* const bytes = reinterpret_cast<const uint8_t*>(CHECK_INPUT);
+	utsAssert(AT24CxCrc::crc16(AT24CxCrc::CRC16_INIT, bytes, CHECK_LENGTH) == CRC16_CHECK);
+	utsAssert(AT24CxCrc::crc32Final(AT24CxCrc::crc32(AT24CxCrc::CRC32_INIT, bytes, CHECK_LENGTH)) == CRC32_CHECK);
+}
+
+AT24Cx_TEST(AT24CxCrc, crcRangeMatchesCheckValues) {
+	static AT24CxFakeTransport<AT24C256> bus;
+	AT24C256 eeprom(bus, 0);
+
+	// The range crosses a page boundary.
+	const uint32_t address = AT24C256::PAGE_SIZE - 4;
+	memcpy(bus.memory() + address, CHECK_INPUT, CHECK_LENGTH);
+
+	uint16_t crc16 = 0;
+	utsAssert(eeprom.crcRange(address, CHECK_LENGTH, crc16));
+	utsAssert(crc16 == CRC16_CHECK);
+	uint32_t crc32 = 0;
+	utsAssert(eeprom.crcRange(address, CHECK_LENGTH, crc32));
+	utsAssert(crc32 == CRC32_CHECK);
+
+	utsAssert(eeprom.verifyRange(address, CHECK_LENGTH, CRC32_CHECK) == AT24CxEeprom::Status::OK);
+	utsAssert(eeprom.verifyRange16(address, CHECK_LENGTH, CRC16_CHECK) == AT24CxEeprom::Status::OK);
+}
+
+AT24Cx_TEST(AT24CxCrc, crcRangeOfLongRange) {
+	static AT24CxFakeTransport<AT24C256> bus;
+	AT24C256 eeprom(bus, 0);
+	for (uint32_t i = 0; i < 1000; i++) {
+		bus.memory()[0x1000 + i] = static_cast<uint8_t>(i * 13);
+	}
+
+	// Read in many transfers, the CRC equals the one over the whole buffer.
+	const uint8_t* const bytes = bus.memory() + 0x1000;
+	uint32_t crc32 = 0;
+	utsAssert(eeprom.crcRange(0x1000, 1000, crc32));
+	utsAssert(crc32 == AT24CxCrc::crc32Final(AT24CxCrc::crc32(AT24CxCrc::CRC32_INIT, bytes, 1000)));
+	uint16_t crc16 = 0;
+	utsAssert(eeprom.crcRange(0x1000, 1000, crc16));
+	utsAssert(crc16 == AT24CxCrc::crc16(AT24CxCrc::CRC16_INIT, bytes, 1000));
+}
@@ -0,0 +1,279 @@
+/*
+  AT24eeprom - Arduino libary for driving the AT24 I2 based eeproms Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/AT24eeprom/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+/*
+  Tests of the AT24CxEeprom core and of AT24CxFakeTransport.
+*/
+
+#include <string.h>
+
+#include "AT24CxEeprom.h"
+#include "AT24CxFakeTransport.h"
+#include "AT24CxHostTest.h"
+
+namespace { // anonymous
+
+void fillPattern(uint8_t* bytes, const size_t count, const uint8_t seed) {
+	for (size_t i = 0; i < count; i++) {
+		bytes[i] = static_cast<uint8_t>(i * 7 + seed);
+	}
+}
+
+/**
+ * Fake transport that records the device addresses of the transfers, one
+ * bit per address 0x50 to 0x57.
+ */
+template<class CHIP>
+class DeviceAddressLog : public AT24CxFakeTransport<CHIP> {
+public:
+	DeviceAddressLog() : mAddresses(0) {}
+
+	void beginTransmission(const uint8_t deviceAddress) override {
+		log(deviceAddress);
+		AT24CxFakeTransport<CHIP>::beginTransmission(deviceAddress);
+	}
+
+	size_t requestFrom(const uint8_t deviceAddress, const uint8_t* wordAddress,
+			const uint8_t wordAddressLength, const size_t count, uint8_t& error) override {
+		log(deviceAddress);
+		return AT24CxFakeTransport<CHIP>::requestFrom(deviceAddress, wordAddress,
+			wordAddressLength, count, error);
+	}
+
+	uint8_t addresses() const {return mAddresses;}
+	void clearAddresses() {mAddresses = 0;}
+
+private:
+	uint8_t mAddresses;
+
+	void log(const uint8_t deviceAddress) {
+		if ((deviceAddress & 0xF8) == 0x50) {
+			mAddresses |= static_cast<uint8_t>(1 << (deviceAddress & 0x07));
+		}
+	}
+};
+
+} // anonymous namespace
+
+AT24Cx_TEST(AT24CxEeprom, writeAndReadAcrossPages) {
+	static AT24CxFakeTransport<AT24C256> bus;
+	AT24C256 eeprom(bus, 0);
+	eeprom.begin();
+
+	uint8_t bytes[300];
+	uint8_t readBack[300];
+	fillPattern(bytes, sizeof(bytes), 1);
+	const uint32_t address = AT24C256::PAGE_SIZE - 5;
+	utsAssert(eeprom.write(address, bytes, sizeof(bytes)));
+	utsAssert(memcmp(bus.memory() + address, bytes, sizeof(bytes)) == 0);
+	utsAssert(bus.memory()[address - 1] == 0xFF);
+	utsAssert(bus.memory()[address + sizeof(bytes)] == 0xFF);
+	utsAssert(bus.writeCycles() == eeprom.expectedWriteCycles(address, sizeof(bytes)));
+
+	utsAssert(eeprom.read(address, readBack, sizeof(readBack)));
+	utsAssert(memcmp(readBack, bytes, sizeof(bytes)) == 0);
+}
+
+AT24Cx_TEST(AT24CxEeprom, readWrapsAtTheEnd) {
+	static AT24CxFakeTransport<AT24C64> bus;
+	AT24C64 eeprom(bus, 0);
+	bus.memory()[AT24C64::TOTAL_SIZE - 1] = 0x12;
+	bus.memory()[0] = 0x34;
+
+	uint8_t readBack[2];
+	utsAssert(eeprom.read(AT24C64::TOTAL_SIZE - 1, readBack, 2));
+	utsAssert(readBack[0] == 0x12 && readBack[1] == 0x34);
+}
+
+AT24Cx_TEST(AT24CxEeprom, blockSelectBits) {
+	static AT24CxFakeTransport<AT24C16> bus;
+	AT24C16 eeprom(bus, 0);
+	uint8_t bytes[40];
+	uint8_t readBack[40];
+	fillPattern(bytes, sizeof(bytes), 3);
+
+	// The range crosses from block 2 into block 3.
+	const uint32_t address = 0x2F0;
+	utsAssert(eeprom.write(address, bytes, sizeof(bytes)));
+	utsAssert(memcmp(bus.memory() + address, bytes, sizeof(bytes)) == 0);
+	utsAssert(eeprom.read(address, readBack, sizeof(readBack)));
+	utsAssert(memcmp(readBack, bytes, sizeof(bytes)) == 0);
+}
+
+AT24Cx_TEST(AT24CxEeprom, cursorContinuesAtTheCounter) {
+	static AT24CxFakeTransport<AT24C256> bus;
+	AT24C256 eeprom(bus, 0);
+	fillPattern(bus.memory(), 64, 5);
+
+	AT24CxEeprom::ReadCursor cursor(eeprom, 0);
+	uint8_t readBack[16];
+	utsAssert(cursor.read(readBack, sizeof(readBack)));
+	const uint32_t writeTransfers = bus.writeTransfers();
+	utsAssert(cursor.read(readBack, sizeof(readBack)));
+	utsAssert(memcmp(readBack, bus.memory() + 16, sizeof(readBack)) == 0);
+	// No address phase for the second read.
+	utsAssert(bus.writeTransfers() == writeTransfers);
+}
+
+AT24Cx_TEST(AT24CxEeprom, retriesTransientErrors) {
+	static AT24CxFakeTransport<AT24C256> bus;
+	AT24C256 eeprom(bus, 0);
+	uint8_t bytes[8];
+	fillPattern(bytes, sizeof(bytes), 9);
+
+	bus.setWriteCyclePolls(20);
+	bus.injectErrors(2, 3);
+	utsAssert(eeprom.write(0x100, bytes, sizeof(bytes)));
+	utsAssert(memcmp(bus.memory() + 0x100, bytes, sizeof(bytes)) == 0);
+	utsAssert(eeprom.writeCycleTime() > 0);
+
+	bus.injectErrors(3, 2);
+	uint8_t readBack[8];
+	utsAssert(eeprom.read(0x100, readBack, sizeof(readBack)));
+	utsAssert(memcmp(readBack, bytes, sizeof(bytes)) == 0);
+}
+
+AT24Cx_TEST(AT24CxEeprom, reportsPersistentErrors) {
+	static AT24CxFakeTransport<AT24C256> bus;
+	AT24C256 eeprom(bus, 0);
+	uint8_t byte = 0;
+
+	bus.injectErrors(4, 10000);
+	AT24CxEeprom::Status status = eeprom.read(0, byte);
+	utsAssert(not status);
+	utsAssert(status == AT24CxEeprom::Status::BUS_ERROR);
+	bus.injectErrors(0, 0);
+
+	// Without retries, a single error fails the write.
+	eeprom.setRetryPolicy(AT24CxEeprom::RetryPolicy(1));
+	bus.injectErrors(3, 1);
+	status = eeprom.write(0, 0x42);
+	utsAssert(status == AT24CxEeprom::Status::DATA_NACK);
+	utsAssert(bus.memory()[0] == 0xFF);
+
+	// A missing eeprom does not acknowledge its device address.
+	AT24C256 missing(bus, 5);
+	status = missing.read(0, byte);
+	utsAssert(status == AT24CxEeprom::Status::ADDRESS_NACK);
+}
+
+AT24Cx_TEST(AT24CxFakeTransport, pageWriteRollsOver) {
+	static AT24CxFakeTransport<AT24C02> bus;
+	const uint8_t transfer[] = {0x06, 1, 2, 3, 4};
+
+	// Bytes beyond the end of the 8 byte page roll over to its start.
+	bus.beginTransmission(0x50);
+	utsAssert(bus.write(transfer, sizeof(transfer)) == sizeof(transfer));
+	utsAssert(bus.endTransmission() == 0);
+	utsAssert(bus.memory()[6] == 1 && bus.memory()[7] == 2);
+	utsAssert(bus.memory()[0] == 3 && bus.memory()[1] == 4);
+	utsAssert(bus.memory()[8] == 0xFF);
+	utsAssert(bus.writeCycles() == 1);
+
+	// The eeprom is busy for one poll, and continues after the last byte.
+	bus.beginTransmission(0x50);
+	utsAssert(bus.endTransmission() == 2);
+	uint8_t error = 0;
+	utsAssert(bus.requestFrom(0x50, nullptr, 0, 2, error) == 2 && error == 0);
+	utsAssert(bus.read() == 0xFF && bus.read() == 0xFF);
+	utsAssert(bus.read() == -1);
+}
+
+AT24Cx_TEST(AT24CxFakeTransport, transferBufferLimit) {
+	static AT24CxFakeTransport<AT24C256, 16> bus;
+	AT24C256 eeprom(bus, 0);
+	uint8_t bytes[AT24C256::PAGE_SIZE];
+	fillPattern(bytes, sizeof(bytes), 11);
+
+	// 14 data bytes per transfer, so a page takes 5 write cycles.
+	utsAssert(eeprom.write(0, bytes, sizeof(bytes)));
+	utsAssert(bus.writeCycles() == 5);
+	utsAssert(memcmp(bus.memory(), bytes, sizeof(bytes)) == 0);
+}
+
+AT24Cx_TEST(AT24CxEeprom, blockBitsOfAT24CM02) {
+	static DeviceAddressLog<AT24CM02> bus;
+	AT24CM02 eeprom(bus, 0);
+	static uint8_t bytes[600];
+	static uint8_t readBack[600];
+	fillPattern(bytes, sizeof(bytes), 11);
+
+	// The range crosses the 0x20000 boundary from block 1 into block 2.
+	const uint32_t address = 0x1FF00;
+	utsAssert(eeprom.write(address, bytes, sizeof(bytes)));
+	utsAssert(memcmp(bus.memory() + address, bytes, sizeof(bytes)) == 0);
+	utsAssert(bus.memory()[address - 1] == 0xFF);
+	utsAssert(bus.memory()[address + sizeof(bytes)] == 0xFF);
+	// The polls for the end of the write cycles may use any block.
+	utsAssert((bus.addresses() & ((1 << 1) | (1 << 2) | (1 << 3))) == ((1 << 1) | (1 << 2)));
+
+	bus.clearAddresses();
+	utsAssert(eeprom.read(address, readBack, sizeof(readBack)));
+	utsAssert(memcmp(readBack, bytes, sizeof(bytes)) == 0);
+	utsAssert(bus.addresses() == ((1 << 1) | (1 << 2)));
+
+	// The last block is selected by both bits.
+	utsAssert(eeprom.write(0x3FFF0, bytes, 16));
+	utsAssert(memcmp(bus.memory() + 0x3FFF0, bytes, 16) == 0);
+	utsAssert(bus.addresses() & (1 << 3));
+}
+
+AT24Cx_TEST(AT24CxEeprom, blockBitOfAT24CM01) {
+	static DeviceAddressLog<AT24CM01> bus;
+	AT24CM01 eeprom(bus, 0);
+	uint8_t bytes[300];
+	uint8_t readBack[300];
+	fillPattern(bytes, sizeof(bytes), 13);
+
+	const uint32_t address = 0x10000 - 100;
+	utsAssert(eeprom.write(address, bytes, sizeof(bytes)));
+	utsAssert(memcmp(bus.memory() + address, bytes, sizeof(bytes)) == 0);
+	utsAssert(bus.addresses() == ((1 << 0) | (1 << 1)));
+
+	utsAssert(eeprom.read(address, readBack, sizeof(readBack)));
+	utsAssert(memcmp(readBack, bytes, sizeof(bytes)) == 0);
+}
+
+AT24Cx_TEST(AT24CxEeprom, cursorWrapsAtTheEndOfAT24CM02) {
+	static AT24CxFakeTransport<AT24CM02> bus;
+	AT24CM02 eeprom(bus, 0);
+	fillPattern(bus.memory() + AT24CM02::TOTAL_SIZE - 8, 8, 17);
+	fillPattern(bus.memory(), 8, 19);
+
+	AT24CxEeprom::ReadCursor cursor(eeprom, AT24CM02::TOTAL_SIZE - 8);
+	uint8_t readBack[16];
+	utsAssert(cursor.read(readBack, sizeof(readBack)));
+	utsAssert(memcmp(readBack, bus.memory() + AT24CM02::TOTAL_SIZE - 8, 8) == 0);
+	utsAssert(memcmp(&readBack[8], bus.memory(), 8) == 0);
+	utsAssert(cursor.position() == 8);
+
+	// A read at the last byte wraps as well.
+	uint8_t byte = 0;
+	cursor.seek(0x3FFFF);
+	utsAssert(cursor.read(byte));
+	utsAssert(byte == bus.memory()[0x3FFFF]);
+	utsAssert(cursor.position() == 0);
+	utsAssert(cursor.read(byte));
+	utsAssert(byte == bus.memory()[0]);
+}
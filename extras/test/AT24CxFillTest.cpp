@@ -0,0 +1,104 @@
+/*
+  AT24eeprom - Arduino libary for driving the AT24 I2 based eeproms Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/AT24eeprom/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+/*
+  Tests of AT24CxEeprom::fill() and AT24CxEeprom::eraseAll().
+*/
+
+#include "AT24CxEeprom.h"
+#include "AT24CxFakeTransport.h"
+#include "AT24CxHostTest.h"
+
+namespace { // anonymous
+
+// A whole page and its word address fit into the transfer buffer, like on
+// platforms with a large I2C buffer, so a page is filled with one write cycle.
+template<class CHIP>
+using LargeBufferBus = AT24CxFakeTransport<CHIP, CHIP::PAGE_SIZE + 2>;
+
+} // anonymous namespace
+
+AT24Cx_TEST(AT24CxFill, partialFirstAndLastPage) {
+	static LargeBufferBus<AT24C256> bus;
+	AT24C256 eeprom(bus, 0);
+	const uint32_t pageSize = AT24C256::PAGE_SIZE;
+
+	// 2 bytes on the first page, 3 full pages and 6 bytes on the last page.
+	const uint32_t address = pageSize - 2;
+	const size_t count = 2 + 3 * pageSize + 6;
+	utsAssert(eeprom.fill(address, count, 0xA5));
+	utsAssert(bus.writeCycles() == 5);
+	for (size_t i = 0; i < count; i++) {
+		if (bus.memory()[address + i] != 0xA5) {
+			utsAssert(bus.memory()[address + i] == 0xA5);
+			break;
+		}
+	}
+	utsAssert(bus.memory()[address - 1] == 0xFF);
+	utsAssert(bus.memory()[address + count] == 0xFF);
+}
+
+AT24Cx_TEST(AT24CxFill, skipsFilledPages) {
+	static LargeBufferBus<AT24C256> bus;
+	AT24C256 eeprom(bus, 0);
+	const uint32_t pageSize = AT24C256::PAGE_SIZE;
+
+	// Only the page whose range isn't filled yet is written.
+	bus.memory()[3 * pageSize + 10] = 0x00;
+	utsAssert(eeprom.fill(pageSize, 4 * pageSize, 0xFF, true));
+	utsAssert(bus.writeCycles() == 1);
+	utsAssert(bus.memory()[3 * pageSize + 10] == 0xFF);
+
+	// Without skipping, every page is written.
+	utsAssert(eeprom.fill(pageSize, 4 * pageSize, 0xFF));
+	utsAssert(bus.writeCycles() == 5);
+
+	// Only the part of the page within the range is checked and written.
+	bus.memory()[0] = 0x00;
+	utsAssert(eeprom.fill(1, pageSize - 1, 0xFF, true));
+	utsAssert(bus.writeCycles() == 5);
+	utsAssert(bus.memory()[0] == 0x00);
+}
+
+AT24Cx_TEST(AT24CxFill, eraseAllWritesEveryPageOnce) {
+	static LargeBufferBus<AT24C512> bus;
+	AT24C512 eeprom(bus, 0);
+	bus.erase(0x00);
+
+	// One write cycle per page: 512 for the 512 pages of an AT24C512.
+	utsAssert(eeprom.eraseAll());
+	utsAssert(bus.writeCycles() == AT24C512::TOTAL_SIZE / AT24C512::PAGE_SIZE);
+	utsAssert(bus.writeCycles() == 512);
+	bool erased = true;
+	for (uint32_t i = 0; i < AT24C512::TOTAL_SIZE; i++) {
+		erased = erased && (bus.memory()[i] == 0xFF);
+	}
+	utsAssert(erased);
+
+	// An erased eeprom is only read.
+	bus.memory()[0x8000] = 0x12;
+	utsAssert(eeprom.eraseAll(true));
+	utsAssert(bus.writeCycles() == 513);
+	utsAssert(bus.memory()[0x8000] == 0xFF);
+}
@@ -0,0 +1,76 @@
+/*
+  AT24eeprom - Arduino libary for driving the AT24 I2 based eeproms Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/AT24eeprom/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+/*
+  Runs all host tests, see README.md. The exit status is non-zero if a test
+  fails.
+*/
+
+#include <stdio.h>
+
+#include "AT24CxHostTest.h"
+
+namespace AT24CxHostTest {
+
+static Registration* first = nullptr;
+static Registration* last = nullptr;
+static unsigned failures = 0;
+
+Registration::Registration(const char* suite, const char* name, TestFunction function)
+		: suite(suite), name(name), function(function), next(nullptr) {
+	// Keep the order of definition.
+	if (last != nullptr) {
+		last->next = this;
+	} else {
+		first = this;
+	}
+	last = this;
+}
+
+void check(const bool expression, const char* text, const char* file, const int line) {
+	if (not expression) {
+		printf("  %s:%d: failed: %s\n", file, line, text);
+		++failures;
+	}
+}
+
+} // namespace AT24CxHostTest
+
+int main() {
+	using namespace AT24CxHostTest;
+	unsigned tests = 0;
+	unsigned failedTests = 0;
+	for (Registration* r = first; r != nullptr; r = r->next) {
+		const unsigned before = failures;
+		r->function();
+		++tests;
+		const bool passed = (failures == before);
+		if (not passed) {
+			++failedTests;
+		}
+		printf("%s %s::%s\n", passed ? "ok    " : "FAILED", r->suite, r->name);
+	}
+	printf("%u tests, %u failed\n", tests, failedTests);
+	return (failedTests == 0) ? 0 : 1;
+}
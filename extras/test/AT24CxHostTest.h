@@ -0,0 +1,61 @@
+/*
+  AT24eeprom - Arduino libary for driving the AT24 I2 based eeproms Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/AT24eeprom/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+/*
+  Minimal unit test framework for the host tests. Tests register themselves
+  with AT24Cx_TEST(), the runner in AT24CxHostTest.cpp executes them all.
+*/
+
+#pragma once
+
+#ifndef AT24Cx_HOST_TEST_H_
+#define AT24Cx_HOST_TEST_H_
+
+namespace AT24CxHostTest {
+
+typedef void (*TestFunction)();
+
+class Registration {
+public:
+	Registration(const char* suite, const char* name, TestFunction function);
+
+	const char* const suite;
+	const char* const name;
+	const TestFunction function;
+	Registration* next;
+};
+
+// Record the result of an assertion. The test continues after a failure.
+void check(const bool expression, const char* text, const char* file, const int line);
+
+} // namespace AT24CxHostTest
+
+#define AT24Cx_TEST(suite, name) \
+	static void suite##_##name(); \
+	static AT24CxHostTest::Registration suite##_##name##_registration(#suite, #name, suite##_##name); \
+	static void suite##_##name()
+
+#define utsAssert(expression) AT24CxHostTest::check((expression), #expression, __FILE__, __LINE__)
+
+#endif /* AT24Cx_HOST_TEST_H_ */
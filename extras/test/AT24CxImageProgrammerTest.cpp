@@ -0,0 +1,135 @@
+/*
+  AT24eeprom - Arduino libary for driving the AT24 I2 based eeproms Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/AT24eeprom/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+/*
+  Tests of AT24CxImageProgrammer.
+*/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "AT24CxImageProgrammer.h"
+#include "AT24CxTestBus.h"
+#include "AT24CxHostTest.h"
+
+namespace { // anonymous
+
+// Stream over a text in RAM. Once it is exhausted, waiting for more bytes
+// lets the simulated time pass, so that timeouts expire.
+class TextStream : public Stream {
+public:
+	TextStream(const char* text) : mText(text), mLength(strlen(text)), mIndex(0) {}
+
+	int available() override {
+		if (mIndex >= mLength) {
+			delay(1);
+		}
+		return static_cast<int>(mLength - mIndex);
+	}
+	int read() override {return (mIndex < mLength) ? static_cast<uint8_t>(mText[mIndex++]) : -1;}
+	int peek() override {return (mIndex < mLength) ? static_cast<uint8_t>(mText[mIndex]) : -1;}
+	size_t write(uint8_t) override {return 0;}
+
+private:
+	const char* const mText;
+	const size_t mLength;
+	size_t mIndex;
+};
+
+// Append an Intel HEX data record with count bytes of value to text.
+void appendRecord(char* text, const uint16_t offset, const uint8_t count, const uint8_t value) {
+	char* end = text + strlen(text);
+	uint8_t checksum = static_cast<uint8_t>(count + (offset >> 8) + offset);
+	end += sprintf(end, ":%02X%04X00", count, offset);
+	for (uint8_t i = 0; i < count; i++) {
+		end += sprintf(end, "%02X", value);
+		checksum = static_cast<uint8_t>(checksum + value);
+	}
+	sprintf(end, "%02X\r\n", static_cast<uint8_t>(-checksum));
+}
+
+const char END_OF_FILE[] = ":00000001FF\r\n";
+
+} // anonymous namespace
+
+AT24Cx_TEST(AT24CxImageProgrammer, programsAndSkipsUnchangedPages) {
+	static AT24CxTestBus<AT24C256> bus;
+	AT24C256 eeprom(bus, 0);
+	AT24CxImageProgrammer<AT24C256::PAGE_SIZE> programmer(eeprom);
+
+	char text[512] = "";
+	appendRecord(text, 0x0100, 16, 0xA5);
+	appendRecord(text, 0x0110, 16, 0xA5);
+	appendRecord(text, 0x0180, 4, 0x5A);
+	strcat(text, END_OF_FILE);
+	bus.memory()[0x0120] = 0x77;
+
+	TextStream first(text);
+	utsAssert(programmer.programHex(first) == AT24CxImageProgrammerBase::IMAGE_OK);
+	utsAssert(programmer.pagesProgrammed() == 2);
+	utsAssert(bus.memory()[0x0100] == 0xA5 && bus.memory()[0x011F] == 0xA5);
+	utsAssert(bus.memory()[0x0180] == 0x5A && bus.memory()[0x0183] == 0x5A);
+	// Bytes that the image does not cover are kept.
+	utsAssert(bus.memory()[0x0120] == 0x77);
+	utsAssert(bus.memory()[0x0184] == 0xFF);
+
+	// Programming the same image again writes nothing.
+	const uint32_t writeCycles = bus.writeCycles();
+	TextStream second(text);
+	utsAssert(programmer.programHex(second) == AT24CxImageProgrammerBase::IMAGE_OK);
+	utsAssert(programmer.pagesUnchanged() == 2);
+	utsAssert(programmer.pagesProgrammed() == 0);
+	utsAssert(bus.writeCycles() == writeCycles);
+}
+
+AT24Cx_TEST(AT24CxImageProgrammer, recordBeyondTheEndIsNotProgrammed) {
+	static AT24CxTestBus<AT24C256> bus;
+	AT24C256 eeprom(bus, 0);
+	AT24CxImageProgrammer<AT24C256::PAGE_SIZE> programmer(eeprom);
+
+	// The record starts within the eeprom, but ends beyond it.
+	char text[256] = "";
+	appendRecord(text, 0x7FF8, 16, 0x11);
+	strcat(text, END_OF_FILE);
+
+	TextStream input(text);
+	utsAssert(programmer.programHex(input) == AT24CxImageProgrammerBase::IMAGE_OUT_OF_RANGE);
+	utsAssert(bus.writeCycles() == 0);
+	utsAssert(bus.memory()[0x7FF8] == 0xFF);
+}
+
+AT24Cx_TEST(AT24CxImageProgrammer, binaryImageAndTimeout) {
+	static AT24CxTestBus<AT24C256> bus;
+	AT24C256 eeprom(bus, 0);
+	AT24CxImageProgrammer<AT24C256::PAGE_SIZE> programmer(eeprom);
+
+	TextStream input("0123456789");
+	utsAssert(programmer.programBinary(input, 0x40, 10) == AT24CxImageProgrammerBase::IMAGE_OK);
+	utsAssert(memcmp(bus.memory() + 0x40, "0123456789", 10) == 0);
+
+	// The stream ends before the image does.
+	programmer.setTimeout(10);
+	TextStream shortInput("abc");
+	utsAssert(programmer.programBinary(shortInput, 0x80, 10) == AT24CxImageProgrammerBase::IMAGE_TIMEOUT);
+}
@@ -0,0 +1,193 @@
+/*
+  AT24eeprom - Arduino libary for driving the AT24 I2 based eeproms Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/AT24eeprom/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+/*
+  Tests of AT24CxKeyValueStore.
+*/
+
+#include <string.h>
+
+#include "AT24CxKeyValueStore.h"
+#include "AT24CxTestBus.h"
+#include "AT24CxPowerLossBus.h"
+#include "AT24CxHostTest.h"
+
+namespace { // anonymous
+
+const uint16_t REGION_SIZE = 0x200;
+
+// Fill the active bank with updates of key 1, until the next put() has to
+// compact, then let the power fail after the given number of write cycles
+// of the compaction. The store must come up with the values of before.
+void interruptCompaction(const uint32_t writeCycles) {
+	static AT24CxPowerLossBus<AT24C256> bus;
+	bus.restorePower();
+	bus.erase();
+	uint32_t counter = 0;
+	{
+		AT24C256 eeprom(bus, 0);
+		eeprom.setRetryPolicy(AT24CxEeprom::RetryPolicy(1));
+		AT24CxKeyValueStore<8> store(eeprom, 0, REGION_SIZE);
+		utsAssert(store.begin());
+		utsAssert(store.put(7, "constant", 8));
+		while (store.freeSpace() >= 8 + sizeof(counter)) {
+			++counter;
+			utsAssert(store.put(1, &counter, sizeof(counter)));
+		}
+
+		bus.losePowerAfter(bus.writeCycles() + writeCycles);
+		const uint32_t lost = counter + 1;
+		utsAssert(not store.put(1, &lost, sizeof(lost)));
+	}
+
+	bus.restorePower();
+	AT24C256 eeprom(bus, 0);
+	AT24CxKeyValueStore<8> store(eeprom, 0, REGION_SIZE);
+	utsAssert(store.begin());
+	utsAssert(store.size() == 2);
+	uint32_t value = 0;
+	utsAssert(store.get(1, &value, sizeof(value)));
+	utsAssert(value == counter);
+	char text[8] = {0};
+	utsAssert(store.get(7, text, sizeof(text)));
+	utsAssert(memcmp(text, "constant", 8) == 0);
+
+	// The store works normally afterwards.
+	++counter;
+	utsAssert(store.put(1, &counter, sizeof(counter)));
+	utsAssert(store.get(1, &value, sizeof(value)));
+	utsAssert(value == counter);
+}
+
+} // anonymous namespace
+
+AT24Cx_TEST(AT24CxKeyValueStore, putGetEraseAndRemount) {
+	static AT24CxTestBus<AT24C256> bus;
+	AT24C256 eeprom(bus, 0);
+	{
+		AT24CxKeyValueStore<8> store(eeprom, 0x1000, 0x200);
+		utsAssert(store.begin());
+		utsAssert(store.size() == 0);
+
+		utsAssert(store.put(1, "one", 3));
+		utsAssert(store.put(2, "two", 3));
+		utsAssert(store.put(1, "uno", 3));
+		utsAssert(store.put(3, "three", 5));
+		utsAssert(store.erase(3));
+		utsAssert(not store.erase(3));
+		utsAssert(not store.put(AT24CxKeyValueStoreBase::INVALID_KEY, "x", 1));
+		utsAssert(store.size() == 2);
+	}
+
+	// A new store on the same region sees the latest values only.
+	AT24CxKeyValueStore<8> store(eeprom, 0x1000, 0x200);
+	utsAssert(store.begin());
+	utsAssert(store.size() == 2);
+	utsAssert(not store.contains(3));
+
+	char value[8] = {0};
+	uint16_t length = 0;
+	utsAssert(store.get(1, value, sizeof(value), length));
+	utsAssert(length == 3 && memcmp(value, "uno", 3) == 0);
+	utsAssert(store.get(2, value, sizeof(value), length));
+	utsAssert(length == 3 && memcmp(value, "two", 3) == 0);
+	utsAssert(not store.get(3, value, sizeof(value), length));
+
+	// A longer value is truncated to the size of the location.
+	utsAssert(store.put(4, "abcdef", 6));
+	utsAssert(store.get(4, value, 2, length));
+	utsAssert(length == 6 && memcmp(value, "ab", 2) == 0);
+}
+
+AT24Cx_TEST(AT24CxKeyValueStore, compactionKeepsLiveEntries) {
+	static AT24CxTestBus<AT24C256> bus;
+	AT24C256 eeprom(bus, 0);
+	AT24CxKeyValueStore<8> store(eeprom, 0, 0x200);
+	utsAssert(store.begin());
+	utsAssert(store.put(7, "constant", 8));
+
+	// Overwriting a key fills the bank several times over, so the store
+	// has to compact repeatedly.
+	const uint16_t initialFreeSpace = store.freeSpace();
+	bool compacted = false;
+	for (uint32_t i = 0; i < 100; i++) {
+		const uint16_t freeSpace = store.freeSpace();
+		utsAssert(store.put(1, &i, sizeof(i)));
+		compacted = compacted || store.freeSpace() > freeSpace;
+	}
+	utsAssert(compacted);
+	utsAssert(store.freeSpace() < initialFreeSpace);
+
+	AT24CxKeyValueStore<8> remounted(eeprom, 0, 0x200);
+	utsAssert(remounted.begin());
+	utsAssert(remounted.size() == 2);
+	uint32_t counter = 0;
+	utsAssert(remounted.get(1, &counter, sizeof(counter)));
+	utsAssert(counter == 99);
+	char value[8] = {0};
+	utsAssert(remounted.get(7, value, sizeof(value)));
+	utsAssert(memcmp(value, "constant", 8) == 0);
+}
+
+AT24Cx_TEST(AT24CxKeyValueStore, eraseKeepsCollidingKeys) {
+	static AT24CxTestBus<AT24C256> bus;
+	AT24C256 eeprom(bus, 0);
+	AT24CxKeyValueStore<8> store(eeprom, 0, REGION_SIZE);
+	utsAssert(store.begin());
+
+	// Keys 1, 9 and 17 share their home slot in the index, key 8 has the
+	// following slot as its home and is displaced by them.
+	const uint16_t keys[] = {1, 9, 17, 8};
+	for (uint16_t i = 0; i < 4; i++) {
+		utsAssert(store.put(keys[i], &keys[i], sizeof(keys[i])));
+	}
+
+	// Erasing the first key of the probe sequence shifts the others back.
+	utsAssert(store.erase(1));
+	utsAssert(store.erase(17));
+	utsAssert(store.size() == 2);
+	utsAssert(not store.contains(1) && not store.contains(17));
+	uint16_t value = 0;
+	utsAssert(store.get(9, &value, sizeof(value)) && value == 9);
+	utsAssert(store.get(8, &value, sizeof(value)) && value == 8);
+
+	// Replaying the log on start up ends with the same index.
+	AT24CxKeyValueStore<8> remounted(eeprom, 0, REGION_SIZE);
+	utsAssert(remounted.begin());
+	utsAssert(remounted.size() == 2);
+	utsAssert(not remounted.contains(1) && not remounted.contains(17));
+	utsAssert(remounted.get(9, &value, sizeof(value)) && value == 9);
+	utsAssert(remounted.get(8, &value, sizeof(value)) && value == 8);
+}
+
+AT24Cx_TEST(AT24CxKeyValueStore, powerLossDuringBankSwitch) {
+	// Power lost after the first value has been copied to the other bank.
+	interruptCompaction(1);
+	// Power lost after all entries have been copied, before the header of
+	// the other bank has been written.
+	interruptCompaction(4);
+	// Power lost after the header of the other bank has been written,
+	// before the new entry has been appended.
+	interruptCompaction(5);
+}
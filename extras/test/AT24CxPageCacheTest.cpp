@@ -0,0 +1,141 @@
+/*
+  AT24eeprom - Arduino libary for driving the AT24 I2 based eeproms Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/AT24eeprom/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+/*
+  Tests of AT24CxPageCache.
+*/
+
+#include "AT24CxPageCache.h"
+#include "AT24CxTestBus.h"
+#include "AT24CxHostTest.h"
+
+AT24Cx_TEST(AT24CxPageCache, smallWritesCostOneWriteCycle) {
+	static AT24CxTestBus<AT24C256> bus;
+	AT24C256 eeprom(bus, 0);
+	AT24CxPageCache<2, AT24C256::PAGE_SIZE> cache(eeprom);
+
+	for (uint8_t i = 0; i < 8; i++) {
+		utsAssert(cache.write(0x200 + 4 * i, i));
+	}
+	utsAssert(cache.isDirty());
+	utsAssert(bus.writeCycles() == 0);
+
+	// Reads are served from the cache before the page is written.
+	uint8_t byte = 0;
+	utsAssert(cache.read(0x200 + 4 * 5, byte));
+	utsAssert(byte == 5);
+
+	// The dirty span fits into a single transfer.
+	utsAssert(cache.flush());
+	utsAssert(not cache.isDirty());
+	utsAssert(bus.writeCycles() == 1);
+	for (uint8_t i = 0; i < 8; i++) {
+		utsAssert(bus.memory()[0x200 + 4 * i] == i);
+	}
+	// Bytes between the written ones keep their content.
+	utsAssert(bus.memory()[0x201] == 0xFF);
+
+	// Flushing a clean cache doesn't write again.
+	utsAssert(cache.flush());
+	utsAssert(bus.writeCycles() == 1);
+}
+
+AT24Cx_TEST(AT24CxPageCache, evictionWritesLeastRecentlyUsedPage) {
+	static AT24CxTestBus<AT24C256> bus;
+	AT24C256 eeprom(bus, 0);
+	AT24CxPageCache<2, AT24C256::PAGE_SIZE> cache(eeprom);
+	const uint32_t pageSize = AT24C256::PAGE_SIZE;
+
+	utsAssert(cache.write(0 * pageSize, 0xA0));
+	utsAssert(cache.write(1 * pageSize, 0xA1));
+	utsAssert(cache.write(0 * pageSize + 1, 0xB0));
+	utsAssert(bus.writeCycles() == 0);
+
+	// A third page evicts page 1, which was used least recently.
+	utsAssert(cache.write(2 * pageSize, 0xA2));
+	utsAssert(bus.writeCycles() == 1);
+	utsAssert(bus.memory()[1 * pageSize] == 0xA1);
+	utsAssert(bus.memory()[0 * pageSize] == 0xFF);
+
+	utsAssert(cache.flushPage(0));
+	utsAssert(bus.writeCycles() == 2);
+	utsAssert(bus.memory()[0] == 0xA0 && bus.memory()[1] == 0xB0);
+	utsAssert(bus.memory()[2 * pageSize] == 0xFF);
+	utsAssert(cache.isDirty());
+}
+
+AT24Cx_TEST(AT24CxPageCache, readsRefreshTheEvictionOrder) {
+	static AT24CxTestBus<AT24C256> bus;
+	AT24C256 eeprom(bus, 0);
+	AT24CxPageCache<2, AT24C256::PAGE_SIZE> cache(eeprom);
+	const uint32_t pageSize = AT24C256::PAGE_SIZE;
+
+	utsAssert(cache.write(0 * pageSize + 4, 0xA0));
+	utsAssert(cache.write(1 * pageSize + 4, 0xA1));
+
+	// Reading page 0 makes page 1 the least recently used one, so page 1
+	// is evicted for page 2, although it has been written last.
+	uint8_t byte = 0;
+	utsAssert(cache.read(0 * pageSize + 4, byte));
+	utsAssert(byte == 0xA0);
+	utsAssert(cache.write(2 * pageSize + 4, 0xA2));
+	utsAssert(bus.writeCycles() == 1);
+	utsAssert(bus.memory()[1 * pageSize + 4] == 0xA1);
+	utsAssert(bus.memory()[0 * pageSize + 4] == 0xFF);
+
+	// The evicted page is loaded again, its bytes come from the eeprom.
+	utsAssert(cache.write(1 * pageSize + 5, 0xB1));
+	utsAssert(bus.writeCycles() == 2);
+	utsAssert(bus.memory()[0 * pageSize + 4] == 0xA0);
+	utsAssert(cache.read(1 * pageSize + 4, byte));
+	utsAssert(byte == 0xA1);
+	utsAssert(cache.flush());
+	utsAssert(bus.memory()[1 * pageSize + 5] == 0xB1);
+	utsAssert(bus.memory()[2 * pageSize + 4] == 0xA2);
+}
+
+AT24Cx_TEST(AT24CxPageCache, failedEvictionKeepsDirtyPage) {
+	static AT24CxTestBus<AT24C256> bus;
+	AT24C256 eeprom(bus, 0);
+	eeprom.setRetryPolicy(AT24CxEeprom::RetryPolicy(1));
+	AT24CxPageCache<1, AT24C256::PAGE_SIZE> cache(eeprom);
+	const uint32_t pageSize = AT24C256::PAGE_SIZE;
+
+	utsAssert(cache.write(0, 0x11));
+
+	// Writing back the dirty page fails, so the page is not evicted and the
+	// new write is refused.
+	bus.injectErrors(4, 1);
+	utsAssert(not cache.write(pageSize, 0x22));
+	utsAssert(cache.isDirty());
+	uint8_t byte = 0;
+	utsAssert(cache.read(0, byte));
+	utsAssert(byte == 0x11);
+	utsAssert(bus.memory()[0] == 0xFF);
+
+	utsAssert(cache.write(pageSize, 0x22));
+	utsAssert(cache.flush());
+	utsAssert(bus.memory()[0] == 0x11);
+	utsAssert(bus.memory()[pageSize] == 0x22);
+}
@@ -0,0 +1,76 @@
+/*
+  AT24eeprom - Arduino libary for driving the AT24 I2 based eeproms Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/AT24eeprom/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+/*
+  Fake eeprom bus for the host tests, that loses power after a given number
+  of write cycles. Every following transfer fails until the power is
+  restored, so the state of the eeprom after a power loss can be tested.
+*/
+
+#pragma once
+
+#ifndef AT24Cx_POWER_LOSS_BUS_H_
+#define AT24Cx_POWER_LOSS_BUS_H_
+
+#include "AT24CxTestBus.h"
+
+template<class CHIP>
+class AT24CxPowerLossBus : public AT24CxTestBus<CHIP> {
+public:
+	AT24CxPowerLossBus() : mPowerLossWriteCycles(0), mPowerLossArmed(false) {}
+
+	/**
+	 * Lose the power as soon as the eeprom has executed writeCycles write
+	 * cycles in total, or at once if it already has.
+	 */
+	void losePowerAfter(const uint32_t writeCycles) {
+		mPowerLossWriteCycles = writeCycles;
+		mPowerLossArmed = true;
+		checkPower();
+	}
+
+	void restorePower() {
+		mPowerLossArmed = false;
+		this->injectErrors(2, 0);
+	}
+
+	uint8_t endTransmission() override {
+		const uint8_t result = AT24CxTestBus<CHIP>::endTransmission();
+		checkPower();
+		return result;
+	}
+
+private:
+	uint32_t mPowerLossWriteCycles;
+	bool mPowerLossArmed;
+
+	void checkPower() {
+		if (mPowerLossArmed && this->writeCycles() >= mPowerLossWriteCycles) {
+			// Without power, the eeprom doesn't acknowledge its address anymore.
+			this->injectErrors(2, 0xFFFF);
+		}
+	}
+};
+
+#endif /* AT24Cx_POWER_LOSS_BUS_H_ */
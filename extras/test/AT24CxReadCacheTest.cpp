@@ -0,0 +1,125 @@
+/*
+  AT24eeprom - Arduino libary for driving the AT24 I2 based eeproms Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/AT24eeprom/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+/*
+  Tests of AT24CxReadCache.
+*/
+
+#include "AT24CxReadCache.h"
+#include "AT24CxTestBus.h"
+#include "AT24CxHostTest.h"
+
+AT24Cx_TEST(AT24CxReadCache, repeatedReadsHitTheCache) {
+	static AT24CxTestBus<AT24C256> bus;
+	for (uint32_t i = 0; i < 0x100; i++) {
+		bus.memory()[i] = static_cast<uint8_t>(i);
+	}
+	AT24C256 eeprom(bus, 0);
+	AT24CxReadCache<4, 32> cache(eeprom);
+
+	uint8_t byte = 0;
+	utsAssert(eeprom.read(0x45, byte) == AT24CxEeprom::Status::OK);
+	utsAssert(byte == 0x45);
+	utsAssert(cache.misses() == 1 && cache.hits() == 0);
+	const uint32_t readTransfers = bus.readTransfers();
+
+	// Further reads of the same line don't touch the bus.
+	uint8_t bytes[4] = {0};
+	utsAssert(eeprom.read(0x50, bytes, sizeof(bytes)) == AT24CxEeprom::Status::OK);
+	utsAssert(bytes[0] == 0x50 && bytes[3] == 0x53);
+	utsAssert(eeprom.read(0x5F, byte) == AT24CxEeprom::Status::OK);
+	utsAssert(byte == 0x5F);
+	utsAssert(cache.hits() == 2 && cache.misses() == 1);
+	utsAssert(bus.readTransfers() == readTransfers);
+
+	// A read that is larger than a line bypasses the cache.
+	uint8_t block[40] = {0};
+	utsAssert(eeprom.read(0x80, block, sizeof(block)) == AT24CxEeprom::Status::OK);
+	utsAssert(block[0] == 0x80 && block[39] == 0xA7);
+	utsAssert(cache.hits() == 2 && cache.misses() == 1);
+
+	// invalidate() drops the lines.
+	cache.invalidate();
+	utsAssert(eeprom.read(0x45, byte) == AT24CxEeprom::Status::OK);
+	utsAssert(cache.misses() == 2);
+}
+
+AT24Cx_TEST(AT24CxReadCache, writesInvalidateCachedLines) {
+	static AT24CxTestBus<AT24C256> bus;
+	AT24C256 eeprom(bus, 0);
+	AT24CxReadCache<2, 32> cache(eeprom);
+
+	uint8_t byte = 0;
+	utsAssert(eeprom.read(0x100, byte) == AT24CxEeprom::Status::OK);
+	utsAssert(byte == 0xFF);
+
+	utsAssert(eeprom.write(0x101, 0x5A) == AT24CxEeprom::Status::OK);
+	utsAssert(eeprom.read(0x101, byte) == AT24CxEeprom::Status::OK);
+	utsAssert(byte == 0x5A);
+	utsAssert(cache.misses() == 2);
+
+	// A write to another line keeps the cached line.
+	utsAssert(eeprom.write(0x200, 0x11) == AT24CxEeprom::Status::OK);
+	utsAssert(eeprom.read(0x100, byte) == AT24CxEeprom::Status::OK);
+	utsAssert(byte == 0xFF);
+	utsAssert(cache.misses() == 2 && cache.hits() == 1);
+}
+
+AT24Cx_TEST(AT24CxReadCache, sequentialMissesPrefetchTheNextLine) {
+	static AT24CxTestBus<AT24C256, 64> bus;
+	for (uint32_t i = 0; i < 0x2000; i++) {
+		bus.memory()[i] = static_cast<uint8_t>(i * 3);
+	}
+	AT24C256 eeprom(bus, 0);
+	AT24CxReadCache<4, 32> cache(eeprom);
+	uint8_t bytes[32];
+
+	// A single miss loads a single line. The second of two sequential
+	// misses loads the following line as well.
+	utsAssert(eeprom.read(0x1000, bytes, sizeof(bytes)) == AT24CxEeprom::Status::OK);
+	utsAssert(eeprom.read(0x1020, bytes, sizeof(bytes)) == AT24CxEeprom::Status::OK);
+	utsAssert(cache.misses() == 2 && cache.hits() == 0);
+	utsAssert(eeprom.read(0x1040, bytes, sizeof(bytes)) == AT24CxEeprom::Status::OK);
+	utsAssert(cache.misses() == 2 && cache.hits() == 1);
+
+	// The prefetched line comes with the same read.
+	cache.invalidate();
+	utsAssert(eeprom.read(0x000, bytes, sizeof(bytes)) == AT24CxEeprom::Status::OK);
+	uint32_t readTransfers = bus.readTransfers();
+	utsAssert(eeprom.read(0x020, bytes, sizeof(bytes)) == AT24CxEeprom::Status::OK);
+	utsAssert(bus.readTransfers() == readTransfers + 1);
+	readTransfers = bus.readTransfers();
+	utsAssert(eeprom.read(0x040, bytes, sizeof(bytes)) == AT24CxEeprom::Status::OK);
+	utsAssert(bus.readTransfers() == readTransfers);
+	utsAssert(bytes[0] == static_cast<uint8_t>(0x40 * 3));
+	utsAssert(bytes[31] == static_cast<uint8_t>(0x5F * 3));
+
+	// A miss on the line after the prefetched one continues the sequence.
+	utsAssert(eeprom.read(0x060, bytes, sizeof(bytes)) == AT24CxEeprom::Status::OK);
+	readTransfers = bus.readTransfers();
+	utsAssert(eeprom.read(0x080, bytes, sizeof(bytes)) == AT24CxEeprom::Status::OK);
+	utsAssert(bus.readTransfers() == readTransfers);
+	utsAssert(bytes[0] == static_cast<uint8_t>(0x80 * 3));
+	utsAssert(cache.hits() == 3 && cache.misses() == 5);
+}
@@ -0,0 +1,218 @@
+/*
+  AT24eeprom - Arduino libary for driving the AT24 I2 based eeproms Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/AT24eeprom/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+/*
+  Tests of the Status results and of the retry policy of AT24CxEeprom.
+*/
+
+#include <string.h>
+
+#include "AT24CxEeprom.h"
+#include "AT24CxTestBus.h"
+#include "AT24CxHostTest.h"
+
+namespace { // anonymous
+
+/**
+ * Test bus whose eeprom does not acknowledge the word address of the
+ * following transfers, while it still acknowledges the probes that poll
+ * for the end of a write cycle.
+ */
+class DataNackBus : public AT24CxTestBus<AT24C256> {
+public:
+	DataNackBus() : mFailures(0), mFailedTransfers(0), mData(false) {}
+
+	void failTransfers(const uint32_t count) {
+		mFailures = count;
+		mFailedTransfers = 0;
+	}
+
+	uint32_t failedTransfers() const {return mFailedTransfers;}
+
+	void beginTransmission(const uint8_t deviceAddress) override {
+		mData = false;
+		AT24CxTestBus<AT24C256>::beginTransmission(deviceAddress);
+	}
+
+	size_t write(const uint8_t byte) override {
+		mData = true;
+		return AT24CxTestBus<AT24C256>::write(byte);
+	}
+
+	size_t write(const uint8_t* bytes, const size_t count) override {
+		mData = true;
+		return AT24CxTestBus<AT24C256>::write(bytes, count);
+	}
+
+	uint8_t endTransmission() override {
+		if (mData && fail()) {
+			delayMicroseconds(TEST_BUS_TRANSFER_MICROS);
+			return 3;
+		}
+		return AT24CxTestBus<AT24C256>::endTransmission();
+	}
+
+	size_t requestFrom(const uint8_t deviceAddress, const uint8_t* wordAddress,
+			const uint8_t wordAddressLength, const size_t count, uint8_t& error) override {
+		if (wordAddressLength > 0 && fail()) {
+			delayMicroseconds(TEST_BUS_TRANSFER_MICROS);
+			error = 3;
+			return 0;
+		}
+		return AT24CxTestBus<AT24C256>::requestFrom(deviceAddress, wordAddress,
+			wordAddressLength, count, error);
+	}
+
+private:
+	uint32_t mFailures;
+	uint32_t mFailedTransfers;
+	bool mData;
+
+	bool fail() {
+		if (mFailures == 0) {
+			return false;
+		}
+		--mFailures;
+		++mFailedTransfers;
+		return true;
+	}
+};
+
+} // anonymous namespace
+
+AT24Cx_TEST(AT24CxRetryPolicy, verifyTellsMissingChipFromMismatch) {
+	static AT24CxTestBus<AT24C256> bus;
+	bus.memory()[0x40] = 0x12;
+	AT24C256 eeprom(bus, 0);
+	uint32_t crc = 0;
+	utsAssert(eeprom.crcRange(0x40, 0x20, crc) == AT24CxEeprom::Status::OK);
+	utsAssert(eeprom.verifyRange(0x40, 0x20, crc) == AT24CxEeprom::Status::OK);
+	utsAssert(eeprom.verifyRange(0x40, 0x20, crc ^ 1) == AT24CxEeprom::Status::MISMATCH);
+	uint16_t crc16 = 0;
+	utsAssert(eeprom.crcRange(0x40, 0x20, crc16) == AT24CxEeprom::Status::OK);
+	utsAssert(eeprom.verifyRange16(0x40, 0x20, crc16 ^ 1) == AT24CxEeprom::Status::MISMATCH);
+
+	// No eeprom answers at the device address of this one.
+	AT24C256 missing(bus, 1);
+	const AT24CxEeprom::Status status = missing.verifyRange(0x40, 0x20, crc);
+	utsAssert(status == AT24CxEeprom::Status::ADDRESS_NACK);
+	utsAssert(missing.verifyRange16(0x40, 0x20, crc16) == AT24CxEeprom::Status::ADDRESS_NACK);
+
+	// With a deadline, the missing eeprom reports a timeout instead.
+	missing.setRetryPolicy(AT24CxEeprom::RetryPolicy(10, 0, false, 2000));
+	utsAssert(missing.verifyRange(0x40, 0x20, crc) == AT24CxEeprom::Status::TIMEOUT);
+}
+
+AT24Cx_TEST(AT24CxRetryPolicy, autoProbeReportsMissingChip) {
+	static AT24CxTestBus<AT24C256> bus;
+	AT24C256 eeprom(bus, 0);
+	AT24CxEeprom::ProbeResult result;
+	utsAssert(eeprom.autoProbe(0x100, result) == AT24CxEeprom::Status::OK);
+	utsAssert(result.speed == AT24CxEeprom::CLK_FAST_PLUS);
+	utsAssert(bus.memory()[0x100] == 0xFF);
+
+	AT24C256 missing(bus, 1);
+	utsAssert(missing.autoProbe(0x100, result) == AT24CxEeprom::Status::ADDRESS_NACK);
+	utsAssert(result.errors[0] > 0);
+}
+
+AT24Cx_TEST(AT24CxRetryPolicy, defaultPolicyMakesTenAttempts) {
+	static DataNackBus bus;
+	AT24C256 eeprom(bus, 0);
+	uint8_t bytes[4] = {1, 2, 3, 4};
+
+	// Nine failures are repeated, the tenth attempt succeeds.
+	bus.failTransfers(9);
+	utsAssert(eeprom.write(0x10, bytes, sizeof(bytes)) == AT24CxEeprom::Status::OK);
+	utsAssert(bus.failedTransfers() == 9);
+	utsAssert(memcmp(bus.memory() + 0x10, bytes, sizeof(bytes)) == 0);
+
+	// A NACK of the word address is reported as a data NACK after ten attempts.
+	bus.failTransfers(100);
+	uint8_t readBack[4];
+	utsAssert(eeprom.read(0x10, readBack, sizeof(readBack)) == AT24CxEeprom::Status::DATA_NACK);
+	utsAssert(bus.failedTransfers() == 10);
+	utsAssert(eeprom.write(0x10, bytes, sizeof(bytes)) == AT24CxEeprom::Status::DATA_NACK);
+	utsAssert(bus.failedTransfers() == 20);
+}
+
+AT24Cx_TEST(AT24CxRetryPolicy, missingChipTimesOutWithinDeadline) {
+	static AT24CxTestBus<AT24C256> bus;
+	AT24C256 missing(bus, 1);
+	const uint32_t deadline = 3000;
+	missing.setRetryPolicy(AT24CxEeprom::RetryPolicy(100, 200, false, deadline));
+
+	// A transfer that is in progress when the deadline expires is completed.
+	const uint32_t limit = deadline + TEST_BUS_TRANSFER_MICROS;
+
+	uint8_t bytes[4] = {0};
+	uint32_t start = micros();
+	utsAssert(missing.read(0x10, bytes, sizeof(bytes)) == AT24CxEeprom::Status::TIMEOUT);
+	uint32_t elapsed = micros() - start;
+	utsAssert(elapsed <= limit);
+
+	start = micros();
+	utsAssert(missing.write(0x10, bytes, sizeof(bytes)) == AT24CxEeprom::Status::TIMEOUT);
+	elapsed = micros() - start;
+	utsAssert(elapsed <= limit);
+
+	// Without a deadline, the NACK of the device address is reported.
+	missing.setRetryPolicy(AT24CxEeprom::RetryPolicy(3));
+	utsAssert(missing.read(0x10, bytes, sizeof(bytes)) == AT24CxEeprom::Status::ADDRESS_NACK);
+}
+
+AT24Cx_TEST(AT24CxRetryPolicy, fixedAndExponentialBackoff) {
+	static DataNackBus bus;
+	AT24C256 eeprom(bus, 0);
+	uint8_t bytes[4] = {0};
+	// 4 failed transfers and 3 probes that are answered at once.
+	const uint32_t transfers = 7 * TEST_BUS_TRANSFER_MICROS;
+
+	// 3 repetitions with a fixed pause of 1 ms.
+	eeprom.setRetryPolicy(AT24CxEeprom::RetryPolicy(4, 1000, false));
+	bus.failTransfers(100);
+	uint32_t start = micros();
+	utsAssert(eeprom.read(0x10, bytes, sizeof(bytes)) == AT24CxEeprom::Status::DATA_NACK);
+	uint32_t elapsed = micros() - start;
+	utsAssert(bus.failedTransfers() == 4);
+	utsAssert(elapsed >= 3000 && elapsed <= 3000 + transfers);
+
+	// The pause doubles with every repetition: 1 ms, 2 ms and 4 ms.
+	eeprom.setRetryPolicy(AT24CxEeprom::RetryPolicy(4, 1000, true));
+	bus.failTransfers(100);
+	start = micros();
+	utsAssert(eeprom.read(0x10, bytes, sizeof(bytes)) == AT24CxEeprom::Status::DATA_NACK);
+	elapsed = micros() - start;
+	utsAssert(bus.failedTransfers() == 4);
+	utsAssert(elapsed >= 7000 && elapsed <= 7000 + transfers);
+
+	// A repetition that would end after the deadline isn't waited for.
+	eeprom.setRetryPolicy(AT24CxEeprom::RetryPolicy(4, 1000, true, 5000));
+	bus.failTransfers(100);
+	start = micros();
+	utsAssert(eeprom.read(0x10, bytes, sizeof(bytes)) == AT24CxEeprom::Status::TIMEOUT);
+	elapsed = micros() - start;
+	utsAssert(bus.failedTransfers() == 3);
+	utsAssert(elapsed < 5000);
+}
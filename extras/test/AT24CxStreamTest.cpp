@@ -0,0 +1,105 @@
+/*
+  AT24eeprom - Arduino libary for driving the AT24 I2 based eeproms Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/AT24eeprom/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+/*
+  Tests of AT24CxStream.
+*/
+
+#include <string.h>
+
+#include "AT24CxStream.h"
+#include "AT24CxTestBus.h"
+#include "AT24CxHostTest.h"
+
+AT24Cx_TEST(AT24CxStream, printAndReadBack) {
+	static AT24CxTestBus<AT24C256> bus;
+	AT24C256 eeprom(bus, 0);
+	AT24CxStream<AT24C256::PAGE_SIZE> stream(eeprom, 0x1000, 0x100);
+
+	utsAssert(stream.print("value=") == 6);
+	utsAssert(stream.print(1234) == 4);
+	stream.flush();
+	utsAssert(stream.getWriteError() == 0);
+	utsAssert(memcmp(bus.memory() + 0x1000, "value=1234", 10) == 0);
+	// The window is written with one write cycle per page.
+	utsAssert(bus.writeCycles() == 1);
+
+	utsAssert(stream.seek(6));
+	char text[5] = {0};
+	utsAssert(stream.readBytes(reinterpret_cast<uint8_t*>(text), 4) == 4);
+	utsAssert(strcmp(text, "1234") == 0);
+	utsAssert(stream.position() == 10);
+}
+
+AT24Cx_TEST(AT24CxStream, failedPageWriteKeepsPosition) {
+	static AT24CxTestBus<AT24C256> bus;
+	AT24C256 eeprom(bus, 0);
+	eeprom.setRetryPolicy(AT24CxEeprom::RetryPolicy(1));
+	AT24CxStream<AT24C256::PAGE_SIZE> stream(eeprom, 0, 0x100);
+
+	uint8_t bytes[80];
+	for (size_t i = 0; i < sizeof(bytes); i++) {
+		bytes[i] = static_cast<uint8_t>(i + 1);
+	}
+	utsAssert(stream.write(bytes, 10) == 10);
+
+	// Completing the page fails. The 10 bytes of the first call stay
+	// buffered, the bytes of this call are not written.
+	bus.injectErrors(4, 1);
+	utsAssert(stream.write(&bytes[10], 70) == 0);
+	utsAssert(stream.getWriteError() != 0);
+	utsAssert(stream.position() == 10);
+	utsAssert(bus.memory()[0] == 0xFF);
+
+	// Writing the rest again continues at the right offset.
+	stream.clearWriteError();
+	utsAssert(stream.write(&bytes[10], 70) == 70);
+	utsAssert(stream.position() == 80);
+	stream.flush();
+	utsAssert(stream.getWriteError() == 0);
+	utsAssert(memcmp(bus.memory(), bytes, sizeof(bytes)) == 0);
+}
+
+AT24Cx_TEST(AT24CxStream, failedFlushCanBeRepeated) {
+	static AT24CxTestBus<AT24C256> bus;
+	AT24C256 eeprom(bus, 0);
+	eeprom.setRetryPolicy(AT24CxEeprom::RetryPolicy(1));
+	AT24CxStream<AT24C256::PAGE_SIZE> stream(eeprom, 0, 0x100);
+
+	utsAssert(stream.write(reinterpret_cast<const uint8_t*>("abc"), 3) == 3);
+	// Both the flush and the seek fail to write the buffered bytes.
+	bus.injectErrors(4, 2);
+	stream.flush();
+	utsAssert(stream.getWriteError() != 0);
+	utsAssert(bus.memory()[0] == 0xFF);
+	utsAssert(not stream.seek(0));
+	utsAssert(stream.position() == 3);
+
+	stream.clearWriteError();
+	stream.flush();
+	utsAssert(stream.getWriteError() == 0);
+	utsAssert(memcmp(bus.memory(), "abc", 3) == 0);
+	utsAssert(stream.seek(0));
+	utsAssert(stream.read() == 'a');
+}
@@ -0,0 +1,61 @@
+/*
+  AT24eeprom - Arduino libary for driving the AT24 I2 based eeproms Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/AT24eeprom/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+/*
+  Fake eeprom bus for the host tests. Unlike the plain AT24CxFakeTransport,
+  every transfer advances the simulated clock, like a transfer on a real
+  bus does, so that timeouts expire while an eeprom does not respond.
+*/
+
+#pragma once
+
+#ifndef AT24Cx_TEST_BUS_H_
+#define AT24Cx_TEST_BUS_H_
+
+#include <Arduino.h>
+
+#include "AT24CxFakeTransport.h"
+
+// Duration of a short transfer at 400 kHz.
+static constexpr unsigned TEST_BUS_TRANSFER_MICROS = 100;
+
+template<class CHIP, size_t BufferLength = 32>
+class AT24CxTestBus : public AT24CxFakeTransport<CHIP, BufferLength> {
+public:
+	AT24CxTestBus(const uint8_t deviceAddress = 0) : AT24CxFakeTransport<CHIP, BufferLength>(deviceAddress) {}
+
+	uint8_t endTransmission() override {
+		delayMicroseconds(TEST_BUS_TRANSFER_MICROS);
+		return AT24CxFakeTransport<CHIP, BufferLength>::endTransmission();
+	}
+
+	size_t requestFrom(const uint8_t deviceAddress, const uint8_t* wordAddress,
+			const uint8_t wordAddressLength, const size_t count, uint8_t& error) override {
+		delayMicroseconds(TEST_BUS_TRANSFER_MICROS);
+		return AT24CxFakeTransport<CHIP, BufferLength>::requestFrom(deviceAddress, wordAddress,
+			wordAddressLength, count, error);
+	}
+};
+
+#endif /* AT24Cx_TEST_BUS_H_ */
@@ -0,0 +1,179 @@
+/*
+  AT24eeprom - Arduino libary for driving the AT24 I2 based eeproms Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/AT24eeprom/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+/*
+  Tests of AT24CxTransaction.
+*/
+
+#include <string.h>
+
+#include "AT24CxTransaction.h"
+#include "AT24CxTestBus.h"
+#include "AT24CxPowerLossBus.h"
+#include "AT24CxHostTest.h"
+
+namespace {
+
+typedef AT24CxPowerLossBus<AT24C256> PowerLossBus;
+
+const uint32_t PAGE_SIZE = AT24C256::PAGE_SIZE;
+const uint32_t JOURNAL_ADDRESS = 0x7000;
+
+} // anonymous namespace
+
+AT24Cx_TEST(AT24CxTransaction, commitAndAbort) {
+	static AT24CxTestBus<AT24C256> bus;
+	AT24C256 eeprom(bus, 0);
+	AT24CxTransaction<4, AT24C256::PAGE_SIZE> transaction(eeprom, JOURNAL_ADDRESS);
+	utsAssert(transaction.begin());
+
+	utsAssert(transaction.beginTransaction());
+	utsAssert(not transaction.beginTransaction());
+	utsAssert(transaction.write(PAGE_SIZE - 2, reinterpret_cast<const uint8_t*>("abcd"), 4));
+	utsAssert(transaction.write(5 * PAGE_SIZE, reinterpret_cast<const uint8_t*>("xyz"), 3));
+
+	// Staged writes are visible to read() but not yet in their home pages.
+	uint8_t bytes[4] = {0};
+	utsAssert(transaction.read(PAGE_SIZE - 2, bytes, 4));
+	utsAssert(memcmp(bytes, "abcd", 4) == 0);
+	utsAssert(bus.memory()[PAGE_SIZE - 2] == 0xFF);
+
+	utsAssert(transaction.commit());
+	utsAssert(not transaction.inTransaction());
+	utsAssert(transaction.sequence() == 1);
+	utsAssert(memcmp(bus.memory() + PAGE_SIZE - 2, "abcd", 4) == 0);
+	utsAssert(memcmp(bus.memory() + 5 * PAGE_SIZE, "xyz", 3) == 0);
+
+	// An aborted transaction leaves the home pages alone.
+	utsAssert(transaction.beginTransaction());
+	utsAssert(transaction.write(PAGE_SIZE - 2, reinterpret_cast<const uint8_t*>("ABCD"), 4));
+	transaction.abort();
+	utsAssert(not transaction.inTransaction());
+	utsAssert(memcmp(bus.memory() + PAGE_SIZE - 2, "abcd", 4) == 0);
+	utsAssert(transaction.sequence() == 1);
+
+	// A transaction must not touch more pages than the journal shadows.
+	utsAssert(transaction.beginTransaction());
+	for (uint32_t page = 0; page < 4; page++) {
+		utsAssert(transaction.write(page * PAGE_SIZE, bytes, 1));
+	}
+	utsAssert(not transaction.write(4 * PAGE_SIZE, bytes, 1));
+	transaction.abort();
+}
+
+AT24Cx_TEST(AT24CxTransaction, beginCompletesInterruptedCommit) {
+	static PowerLossBus bus;
+	{
+		AT24C256 eeprom(bus, 0);
+		eeprom.setRetryPolicy(AT24CxEeprom::RetryPolicy(1));
+		AT24CxTransaction<4, AT24C256::PAGE_SIZE> transaction(eeprom, JOURNAL_ADDRESS);
+		utsAssert(transaction.begin());
+		utsAssert(transaction.beginTransaction());
+		utsAssert(transaction.write(PAGE_SIZE - 2, reinterpret_cast<const uint8_t*>("abcd"), 4));
+
+		// Power is lost right after the commit record has been written.
+		bus.losePowerAfter(bus.writeCycles() + 1);
+		utsAssert(not transaction.commit());
+		utsAssert(bus.memory()[PAGE_SIZE - 2] == 0xFF);
+		utsAssert(bus.memory()[PAGE_SIZE] == 0xFF);
+	}
+
+	// Start up again with the default retry policy, which waits for the
+	// write cycle that has been interrupted by the power loss.
+	bus.restorePower();
+	AT24C256 eeprom(bus, 0);
+	AT24CxTransaction<4, AT24C256::PAGE_SIZE> transaction(eeprom, JOURNAL_ADDRESS);
+	utsAssert(transaction.begin());
+	utsAssert(transaction.sequence() == 1);
+	utsAssert(memcmp(bus.memory() + PAGE_SIZE - 2, "abcd", 4) == 0);
+
+	// The record is marked as applied, so a further start up copies nothing.
+	const uint32_t writeCycles = bus.writeCycles();
+	AT24CxTransaction<4, AT24C256::PAGE_SIZE> restarted(eeprom, JOURNAL_ADDRESS);
+	utsAssert(restarted.begin());
+	utsAssert(bus.writeCycles() == writeCycles);
+}
+
+AT24Cx_TEST(AT24CxTransaction, powerLossBeforeCommitRecordChangesNothing) {
+	static PowerLossBus bus;
+	{
+		AT24C256 eeprom(bus, 0);
+		eeprom.setRetryPolicy(AT24CxEeprom::RetryPolicy(1));
+		AT24CxTransaction<4, AT24C256::PAGE_SIZE> transaction(eeprom, JOURNAL_ADDRESS);
+		utsAssert(transaction.begin());
+		utsAssert(transaction.beginTransaction());
+		utsAssert(transaction.write(0, reinterpret_cast<const uint8_t*>("abcd"), 4));
+
+		// Power is lost before the commit record could be written.
+		bus.losePowerAfter(bus.writeCycles());
+		utsAssert(not transaction.commit());
+	}
+
+	bus.restorePower();
+	AT24C256 eeprom(bus, 0);
+	AT24CxTransaction<4, AT24C256::PAGE_SIZE> transaction(eeprom, JOURNAL_ADDRESS);
+	utsAssert(transaction.begin());
+	utsAssert(transaction.sequence() == 0);
+	utsAssert(bus.memory()[0] == 0xFF);
+}
+
+AT24Cx_TEST(AT24CxTransaction, powerLossAtEveryWriteCycleOfCommit) {
+	static PowerLossBus bus;
+	static uint8_t before[2 * PAGE_SIZE];
+	static uint8_t after[2 * PAGE_SIZE];
+	for (uint32_t i = 0; i < sizeof(before); i++) {
+		before[i] = static_cast<uint8_t>(i);
+		after[i] = static_cast<uint8_t>(~i);
+	}
+
+	// The transaction rewrites pages 2 and 3. Lose the power after each
+	// write cycle of the commit in turn, until the commit gets through.
+	bool committed = false;
+	for (uint32_t cycles = 0; not committed && cycles < 20; cycles++) {
+		bus.restorePower();
+		bus.erase();
+		memcpy(bus.memory() + 2 * PAGE_SIZE, before, sizeof(before));
+		{
+			AT24C256 eeprom(bus, 0);
+			eeprom.setRetryPolicy(AT24CxEeprom::RetryPolicy(1));
+			AT24CxTransaction<4, AT24C256::PAGE_SIZE> transaction(eeprom, JOURNAL_ADDRESS);
+			utsAssert(transaction.begin());
+			utsAssert(transaction.beginTransaction());
+			utsAssert(transaction.write(2 * PAGE_SIZE, after, sizeof(after)));
+			bus.losePowerAfter(bus.writeCycles() + cycles);
+			committed = transaction.commit();
+		}
+
+		bus.restorePower();
+		AT24C256 eeprom(bus, 0);
+		AT24CxTransaction<4, AT24C256::PAGE_SIZE> transaction(eeprom, JOURNAL_ADDRESS);
+		utsAssert(transaction.begin());
+		// Either none or all of the writes take effect. Once the commit
+		// record has been written, begin() completes the copying.
+		const uint8_t* const expected = (cycles == 0) ? before : after;
+		utsAssert(memcmp(bus.memory() + 2 * PAGE_SIZE, expected, sizeof(after)) == 0);
+		utsAssert(transaction.sequence() == ((cycles == 0) ? 0 : 1));
+	}
+	utsAssert(committed);
+}
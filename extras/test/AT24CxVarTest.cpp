@@ -0,0 +1,143 @@
+/*
+  AT24eeprom - Arduino libary for driving the AT24 I2 based eeproms Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/AT24eeprom/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+/*
+  Tests of AT24CxVar, AT24CxVarArray and AT24CxVarStruct.
+*/
+
+#include "AT24CxVar.h"
+#include "AT24CxTestBus.h"
+#include "AT24CxHostTest.h"
+
+namespace {
+
+struct Settings {
+	uint32_t baudRate;
+	uint8_t mode;
+	uint8_t flags;
+	uint16_t timeout;
+};
+
+} // anonymous namespace
+
+AT24Cx_TEST(AT24CxVar, commitAndLoad) {
+	static AT24CxTestBus<AT24C256> bus;
+	AT24C256 eeprom(bus, 0);
+	{
+		AT24CxVar<AT24C256, 0x100, uint32_t> bootCount(eeprom);
+		bootCount.set(0x12345678);
+		utsAssert(bootCount.isDirty());
+		utsAssert(bootCount.commit());
+		utsAssert(not bootCount.isDirty());
+		utsAssert(bus.writeCycles() == 1);
+	}
+
+	AT24CxVar<AT24C256, 0x100, uint32_t> bootCount(eeprom);
+	utsAssert(bootCount.load());
+	utsAssert(bootCount.get() == 0x12345678);
+
+	// Setting the loaded value again changes nothing.
+	bootCount.set(0x12345678);
+	utsAssert(not bootCount.isDirty());
+	utsAssert(bootCount.commit());
+	utsAssert(bus.writeCycles() == 1);
+}
+
+AT24Cx_TEST(AT24CxVar, arrayWritesChangedSpanPerPage) {
+	static AT24CxTestBus<AT24C256> bus;
+	AT24C256 eeprom(bus, 0);
+	typedef AT24CxVarArray<AT24C256, 0x200, uint32_t, 32> Table;
+	Table table(eeprom);
+	utsAssert(table.load());
+
+	// Element 4 is changed behind the back of the shadow. It lies outside
+	// of the changed spans, so commit() must not overwrite it.
+	bus.memory()[Table::ADDRESS + 16] = 0x42;
+
+	// Elements 0 and 2 share the first page, element 20 is on the second.
+	table.set(0, 1);
+	table.set(2, 2);
+	table.set(20, 3);
+	utsAssert(table.commit());
+	utsAssert(bus.writeCycles() == 2);
+	utsAssert(bus.memory()[Table::ADDRESS + 0] == 1);
+	utsAssert(bus.memory()[Table::ADDRESS + 8] == 2);
+	utsAssert(bus.memory()[Table::ADDRESS + 80] == 3);
+	utsAssert(bus.memory()[Table::ADDRESS + 16] == 0x42);
+
+	Table reloaded(eeprom);
+	utsAssert(reloaded.load());
+	utsAssert(reloaded.get(20) == 3);
+}
+
+AT24Cx_TEST(AT24CxVar, structFieldsAndFailedCommit) {
+	static AT24CxTestBus<AT24C256> bus;
+	AT24C256 eeprom(bus, 0);
+	eeprom.setRetryPolicy(AT24CxEeprom::RetryPolicy(1));
+	AT24CxVarStruct<AT24C256, 0x300, Settings> settings(eeprom);
+	utsAssert(settings.load());
+
+	settings.set(&Settings::timeout, 500);
+	bus.injectErrors(4, 1);
+	utsAssert(not settings.commit());
+	utsAssert(settings.isDirty());
+
+	// The failed bytes stay changed, so the commit can be repeated.
+	utsAssert(settings.commit());
+	utsAssert(not settings.isDirty());
+	utsAssert(settings.get(&Settings::timeout) == 500);
+	const uint32_t timeoutAddress = settings.ADDRESS + offsetof(Settings, timeout);
+	utsAssert(bus.memory()[timeoutAddress] == (500 & 0xFF));
+	utsAssert(bus.memory()[timeoutAddress + 1] == (500 >> 8));
+	// The other fields haven't been written.
+	utsAssert(bus.memory()[settings.ADDRESS] == 0xFF);
+}
+
+AT24Cx_TEST(AT24CxVar, unloadedShadowWritesOnlySetBytes) {
+	static AT24CxTestBus<AT24C256> bus;
+	for (uint32_t i = 0; i < 0x100; i++) {
+		bus.memory()[0x300 + i] = 0x77;
+	}
+	AT24C256 eeprom(bus, 0);
+
+	// The shadow isn't loaded, so it isn't known to match the eeprom. Only
+	// the field that has been set is written, the rest keeps its content.
+	AT24CxVarStruct<AT24C256, 0x300, Settings> settings(eeprom);
+	settings.set(&Settings::mode, 3);
+	utsAssert(settings.isDirty());
+	utsAssert(settings.commit());
+	utsAssert(bus.writeCycles() == 1);
+	const uint32_t modeAddress = settings.ADDRESS + offsetof(Settings, mode);
+	utsAssert(bus.memory()[modeAddress] == 3);
+	utsAssert(bus.memory()[modeAddress - 1] == 0x77);
+	utsAssert(bus.memory()[modeAddress + 1] == 0x77);
+
+	// A value that crosses a page boundary is written with one write per page.
+	const uint32_t address = 2 * AT24C256::PAGE_SIZE - 2;
+	AT24CxVar<AT24C256, address, uint32_t> value(eeprom);
+	value.set(0x11223344);
+	utsAssert(value.commit());
+	utsAssert(bus.writeCycles() == 3);
+	utsAssert(bus.memory()[address] == 0x44 && bus.memory()[address + 3] == 0x11);
+}
@@ -0,0 +1,127 @@
+/*
+  AT24eeprom - Arduino libary for driving the AT24 I2 based eeproms Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/AT24eeprom/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+/*
+  Tests of AT24CxWearLevelingRecord.
+*/
+
+#include <string.h>
+
+#include "AT24CxWearLevelingRecord.h"
+#include "AT24CxTestBus.h"
+#include "AT24CxHostTest.h"
+
+namespace { // anonymous
+
+struct Counters {
+	uint32_t minutes;
+	uint32_t boots;
+};
+
+} // anonymous namespace
+
+AT24Cx_TEST(AT24CxWearLevelingRecord, slotsArePageAligned) {
+	static AT24CxTestBus<AT24C256> bus;
+	AT24C256 eeprom(bus, 0);
+
+	// 8 + 6 bytes are rounded up to 16, a divisor of the page size.
+	AT24CxWearLevelingRecord<sizeof(Counters)> small(eeprom, 0x1000, 0x400);
+	utsAssert(small.slotSize() == 16);
+	utsAssert(small.slotCount() == 64);
+
+	// 60 + 6 bytes are rounded up to two pages.
+	AT24CxWearLevelingRecord<60> large(eeprom, 0x2000, 0x400);
+	utsAssert(large.slotSize() == 2 * AT24C256::PAGE_SIZE);
+	utsAssert(large.slotCount() == 8);
+}
+
+AT24Cx_TEST(AT24CxWearLevelingRecord, storeCostsOneWriteCycle) {
+	static AT24CxTestBus<AT24C256> bus;
+	AT24C256 eeprom(bus, 0);
+	AT24CxWearLevelingRecord<sizeof(Counters)> record(eeprom, 0x1000, 0x100);
+
+	// The scan reads the region with a single address phase.
+	utsAssert(record.begin());
+	utsAssert(bus.writeTransfers() == 1);
+	utsAssert(not record.hasRecord());
+
+	Counters counters = {1, 2};
+	const uint32_t writeCycles = bus.writeCycles();
+	utsAssert(record.store(&counters));
+	utsAssert(bus.writeCycles() == writeCycles + 1);
+	utsAssert(record.sequence() == 0);
+}
+
+AT24Cx_TEST(AT24CxWearLevelingRecord, newestRecordSurvivesRestart) {
+	static AT24CxTestBus<AT24C256> bus;
+	AT24C256 eeprom(bus, 0);
+	{
+		AT24CxWearLevelingRecord<sizeof(Counters)> record(eeprom, 0x1000, 0x100);
+		// Go round the 16 slots more than once.
+		for (uint32_t i = 0; i < 20; i++) {
+			Counters counters = {i, 2 * i};
+			utsAssert(record.store(&counters));
+		}
+		utsAssert(record.sequence() == 19);
+	}
+
+	AT24CxWearLevelingRecord<sizeof(Counters)> record(eeprom, 0x1000, 0x100);
+	Counters counters = {0, 0};
+	utsAssert(record.load(&counters));
+	utsAssert(counters.minutes == 19 && counters.boots == 38);
+	utsAssert(record.sequence() == 19);
+
+	// The slots are used evenly, each one holds one of the last 16 records.
+	for (uint16_t slot = 0; slot < record.slotCount(); slot++) {
+		uint32_t minutes = 0;
+		memcpy(&minutes, bus.memory() + 0x1000 + slot * record.slotSize(), sizeof(minutes));
+		utsAssert(minutes >= 4 && minutes <= 19);
+	}
+}
+
+AT24Cx_TEST(AT24CxWearLevelingRecord, tornWriteKeepsPreviousRecord) {
+	static AT24CxTestBus<AT24C256> bus;
+	AT24C256 eeprom(bus, 0);
+	{
+		AT24CxWearLevelingRecord<sizeof(Counters)> record(eeprom, 0x1000, 0x100);
+		for (uint32_t i = 0; i < 3; i++) {
+			Counters counters = {i, i};
+			utsAssert(record.store(&counters));
+		}
+	}
+
+	// Corrupt the newest slot, as a power loss during its write would.
+	bus.memory()[0x1000 + 2 * 16 + 1] ^= 0x55;
+
+	AT24CxWearLevelingRecord<sizeof(Counters)> record(eeprom, 0x1000, 0x100);
+	Counters counters = {0, 0};
+	utsAssert(record.load(&counters));
+	utsAssert(counters.minutes == 1);
+	utsAssert(record.sequence() == 1);
+
+	// The next store goes to the slot after the valid one.
+	counters.minutes = 7;
+	utsAssert(record.store(&counters));
+	utsAssert(bus.memory()[0x1000 + 2 * 16] == 7);
+}
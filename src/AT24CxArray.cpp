@@ -0,0 +1,157 @@
+/*
+  AT24eeprom - Arduino libary for driving the AT24 I2 based eeproms Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/AT24eeprom/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+
+#include <stdint.h>
+#include <assert.h>
+#define ASSERT assert
+
+#include "AT24CxArray.h"
+
+#undef min
+static inline size_t min(size_t a, size_t b) {return a < b ? a : b;}
+
+AT24CxArray::AT24CxArray(AT24CxEeprom* const* chips, const uint8_t chipCount)
+		: mChips(chips), mChipCount(chipCount) {
+	ASSERT(chipCount >= 1 && chipCount <= 8);
+	for (uint8_t i = 0; i < chipCount; i++) {
+		ASSERT(chips[i]->totalSize() == chips[0]->totalSize());
+		ASSERT(chips[i]->pageSize() == chips[0]->pageSize());
+		// Small parts use the address pins as block select bits, so the
+		// stripes of two of them would alias each other.
+		ASSERT(chips[i]->addressBytes() >= 2);
+		// The block select bits of the large parts are cleared from the
+		// device address, so chips whose blocks overlap are detected too.
+		for (uint8_t j = 0; j < i; j++) {
+			ASSERT(chips[i]->deviceAddress(0) != chips[j]->deviceAddress(0));
+		}
+	}
+}
+
+void AT24CxArray::begin(AT24CxEeprom::CLOCK_SPEED_HZ speed) {
+	// All chips share the bus, so initializing it once is sufficient.
+	mChips[0]->begin(speed);
+}
+
+size_t AT24CxArray::locate(const uint32_t address, uint8_t& chip, uint32_t& chipAddress) const {
+	const uint32_t page = address / pageSize();
+	const uint32_t pageOffset = address % pageSize();
+	chip = page % mChipCount;
+	chipAddress = (page / mChipCount) * pageSize() + pageOffset;
+	return pageSize() - pageOffset;
+}
+
+void AT24CxArray::tickAll() {
+	for (uint8_t i = 0; i < mChipCount; i++) {
+		mChips[i]->tick();
+	}
+}
+
+void AT24CxArray::waitForChip(const uint8_t chip) {
+	while (mChips[chip]->isBusy()) {
+		// Keep the other chips going while waiting.
+		tickAll();
+	}
+}
+
+bool AT24CxArray::write(const uint32_t address, const uint8_t byte) {
+	return write(address, &byte, 1);
+}
+
+bool AT24CxArray::write(const uint32_t address, const uint8_t *bytes, const size_t count) {
+	ASSERT(address + count <= totalSize());
+
+	// The chips that have got a page with this call. Only their results
+	// count, a chip that has failed before may have recovered meanwhile.
+	uint8_t started = 0;
+	bool success = true;
+	uint32_t a = address;
+	size_t remaining = count;
+	while (success && remaining > 0) {
+		uint8_t chip;
+		uint32_t chipAddress;
+		const size_t n = min(remaining, locate(a, chip, chipAddress));
+		const uint8_t chipBit = static_cast<uint8_t>(1 << chip);
+
+		// The chip is free as soon as the write cycle of its previous page has
+		// completed. The other chips proceed meanwhile. The result of that page
+		// must be checked before the next page of the chip replaces it.
+		waitForChip(chip);
+		success = ((started & chipBit) == 0 || mChips[chip]->asyncWriteSucceeded())
+			&& mChips[chip]->beginWrite(chipAddress, bytes, n);
+		started |= chipBit;
+		bytes += n;
+		a += n;
+		remaining -= n;
+	}
+
+	for (uint8_t i = 0; i < mChipCount; i++) {
+		if ((started & (1 << i)) != 0) {
+			waitForChip(i);
+			success = mChips[i]->asyncWriteSucceeded() && success;
+		}
+	}
+	return success;
+}
+
+bool AT24CxArray::read(const uint32_t address, uint8_t &byte) {
+	return read(address, &byte, 1);
+}
+
+bool AT24CxArray::read(const uint32_t address, uint8_t *bytes, const size_t count) {
+	ASSERT(address + count <= totalSize());
+
+	uint32_t a = address;
+	size_t remaining = count;
+	while (remaining > 0) {
+		uint8_t chip;
+		uint32_t chipAddress;
+		const size_t n = min(remaining, locate(a, chip, chipAddress));
+		if (not mChips[chip]->read(chipAddress, bytes, n)) {
+			return false;
+		}
+		bytes += n;
+		a += n;
+		remaining -= n;
+	}
+	return true;
+}
+
+bool AT24CxArray::read(const uint32_t address, AT24CxEeprom::ReadSink& sink, const size_t count) {
+	ASSERT(address + count <= totalSize());
+
+	uint32_t a = address;
+	size_t remaining = count;
+	while (remaining > 0) {
+		uint8_t chip;
+		uint32_t chipAddress;
+		const size_t n = min(remaining, locate(a, chip, chipAddress));
+		if (not mChips[chip]->read(chipAddress, sink, n)) {
+			return false;
+		}
+		a += n;
+		remaining -= n;
+	}
+	return true;
+}
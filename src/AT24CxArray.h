@@ -0,0 +1,141 @@
+/*
+  AT24eeprom - Arduino libary for driving the AT24 I2 based eeproms Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/AT24eeprom/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+
+#pragma once
+
+#ifndef AT24CxArray_HPP_
+#define AT24CxArray_HPP_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "AT24CxEeprom.h"
+
+/**
+ * Several identical AT24C eeproms on the same I2C bus, that are selected by
+ * their A0..A2 pins, presented as one linear address space. Consecutive
+ * pages are striped across the chips: page 0 is on the first chip, page 1
+ * on the second chip, and so on.
+ *
+ * A write sends each page with an asynchronous write of its chip, so while
+ * one chip is busy with its internal write cycle, the next page is already
+ * sent to the next chip. Bulk writes scale with the number of chips until
+ * the bus itself is saturated.
+ *
+ * The chips must not be written directly while they belong to an array.
+ */
+class AT24CxArray {
+public:
+	/**
+	 * @param chips the chips of the array, all of the same type with two
+	 * address bytes, i.e. AT24C32 or larger, and each at its own device
+	 * address. The array of pointers must stay valid for the lifetime of
+	 * the AT24CxArray.
+	 * @param chipCount the number of chips, 1..8.
+	 */
+	AT24CxArray(AT24CxEeprom* const* chips, const uint8_t chipCount);
+
+	/**
+	 * Initialize I2C bus for communication with the eeproms.
+	 * To be called before any read write operation.
+	 * May be skipped if the I2C bus is already initialized.
+	 * @param speed The frequency that shall be used for the I2C bus communication.
+	 */
+	void begin(AT24CxEeprom::CLOCK_SPEED_HZ speed = AT24CxEeprom::CLK_HIGH_SPEED);
+
+	/**
+	 * Write a single byte.
+	 * @param address array address where the byte shall be written to.
+	 * @param byte the byte that shall be written.
+	 * @return true, on success, otherwise false.
+	 */
+	bool write(const uint32_t address, const uint8_t byte);
+
+	/**
+	 * Write multiple bytes. Returns when all write cycles have been completed.
+	 * @param address array address where the first byte shall be written to.
+	 * @param bytes the bytes that shall be written.
+	 * @return true, on success, otherwise false.
+	 */
+	bool write(const uint32_t address, const uint8_t* bytes, const size_t count);
+
+	/**
+	 * Read a single byte.
+	 * @param address array address from where the byte shall be read.
+	 * @param byte the location where the read byte shall be returned.
+	 * @return true, on success, otherwise false.
+	 */
+	bool read(const uint32_t address, uint8_t& byte);
+
+	/**
+	 * Read multiple bytes.
+	 * @param address array address from where the first byte shall be read.
+	 * @param bytes the location where the read bytes shall be returned.
+	 * @return true, on success, otherwise false.
+	 */
+	bool read(const uint32_t address, uint8_t* bytes, const size_t count);
+
+	/**
+	 * Read multiple bytes and pass them to a sink as they are received.
+	 * @param address array address from where the first byte shall be read.
+	 * @param sink the receiver of the read bytes.
+	 * @return true, on success, otherwise false.
+	 */
+	bool read(const uint32_t address, AT24CxEeprom::ReadSink& sink, const size_t count);
+
+	/**
+	 * get the total size of the array.
+	 * @return the sum of the sizes of all chips in bytes.
+	 */
+	inline uint32_t totalSize() const {return mChipCount * mChips[0]->totalSize();}
+
+	/**
+	 * get the page size of the array, which is the page size of the chips.
+	 * @return the page size in bytes.
+	 */
+	inline uint32_t pageSize() const {return mChips[0]->pageSize();}
+
+	/**
+	 * get the number of chips of the array.
+	 * @return the number of chips.
+	 */
+	inline uint8_t chipCount() const {return mChipCount;}
+
+private:
+	AT24CxEeprom* const* mChips;
+	const uint8_t mChipCount;
+
+	// Map an array address to the chip that holds it and the address within
+	// that chip. Returns the number of bytes up to the end of the page.
+	size_t locate(const uint32_t address, uint8_t& chip, uint32_t& chipAddress) const;
+
+	// Advance the asynchronous writes of all chips.
+	void tickAll();
+
+	// Wait until the asynchronous write of the given chip has completed.
+	void waitForChip(const uint8_t chip);
+};
+
+#endif /* AT24CxArray_HPP_ */
@@ -0,0 +1,82 @@
+/*
+  AT24eeprom - Arduino libary for driving the AT24 I2 based eeproms Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/AT24eeprom/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+
+#pragma once
+
+#ifndef AT24CxCrc_HPP_
+#define AT24CxCrc_HPP_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "AT24CxPlatform.h"
+
+namespace AT24CxCrc {
+
+// Lookup tables, located in flash memory on AVR.
+extern const uint16_t CRC16_TABLE[256] PROGMEM;
+extern const uint32_t CRC32_TABLE[256] PROGMEM;
+
+/**
+ * CRC-16/CCITT-FALSE: polynomial 0x1021, initial value 0xFFFF, no reflection.
+ */
+static constexpr uint16_t CRC16_INIT = 0xFFFF;
+
+inline uint16_t crc16(const uint16_t crc, const uint8_t byte) {
+	return static_cast<uint16_t>(crc << 8)
+		^ pgm_read_word(&CRC16_TABLE[static_cast<uint8_t>(crc >> 8) ^ byte]);
+}
+
+inline uint16_t crc16(uint16_t crc, const uint8_t* bytes, const size_t count) {
+	for (size_t i = 0; i < count; i++) {
+		crc = crc16(crc, bytes[i]);
+	}
+	return crc;
+}
+
+/**
+ * CRC-32 as used by zip and Ethernet: reflected polynomial 0xEDB88320,
+ * initial value 0xFFFFFFFF, final value inverted by crc32Final().
+ */
+static constexpr uint32_t CRC32_INIT = 0xFFFFFFFF;
+
+inline uint32_t crc32(const uint32_t crc, const uint8_t byte) {
+	return (crc >> 8) ^ pgm_read_dword(&CRC32_TABLE[static_cast<uint8_t>(crc) ^ byte]);
+}
+
+inline uint32_t crc32(uint32_t crc, const uint8_t* bytes, const size_t count) {
+	for (size_t i = 0; i < count; i++) {
+		crc = crc32(crc, bytes[i]);
+	}
+	return crc;
+}
+
+inline uint32_t crc32Final(const uint32_t crc) {
+	return ~crc;
+}
+
+} // namespace AT24CxCrc
+
+#endif /* AT24CxCrc_HPP_ */
@@ -26,89 +26,156 @@
 
 
 #include <stdint.h>
+#include <string.h>
 #include <assert.h>
 #define ASSERT assert
 
-#include <Arduino.h>
-#include <Wire.h>
-
+#include "AT24CxPlatform.h"
 #include "AT24CxEeprom.h"
+#include "AT24CxCrc.h"
+#include "AT24CxReadCache.h"
 
 #undef min
 #undef max
 
 static inline size_t min(size_t a, size_t b) {return a < b ? a : b;}
+static inline uint32_t min32(uint32_t a, uint32_t b) {return a < b ? a : b;}
+
+// Spacing of the address-only probes while the eeprom is in its internal write cycle.
+static constexpr uint32_t ACK_POLL_INTERVAL_US = 50;
+
+// Upper bound for the internal write cycle. The datasheets specify 5ms, some
+// older parts 10ms.
+static constexpr uint32_t WRITE_CYCLE_TIMEOUT_US = 10000;
 
-#if defined SIZE_MAX
-static size_t sizeMax() {return SIZE_MAX;}
+// Size of the scratch area that autoProbe() writes its test patterns to.
+static constexpr uint8_t PROBE_SIZE = 8;
+
+#if AT24CxEepromEnableStats
+#define AT24Cx_STATS(statement) statement
 #else
-#include <limits>
-static size_t sizeMax() {return std::numeric_limits<size_t>::max();}
+#define AT24Cx_STATS(statement)
 #endif
 
-static constexpr size_t WRITE_RETRIES = 10;
-static constexpr size_t READ_RETRIES  = 10;
+// Size of the device address byte of a transfer.
+static constexpr uint8_t DEVICE_ADDRESS_SIZE = 1;
 
-void AT24CxEeprom::begin() {
-	mWire.begin();
-}
+// Returned by remainingMicros() if there is no deadline.
+static constexpr uint32_t NO_DEADLINE = 0xFFFFFFFF;
 
-void AT24CxEeprom::begin(CLOCK_SPEED_HZ speed) {
-	begin();
-	mWire.setClock(speed);
+// delayMicroseconds() takes an unsigned int and is only accurate up to
+// about 16ms on AVR, so longer pauses are split.
+static void pauseMicros(uint32_t duration) {
+	static constexpr uint32_t MAX_DELAY_US = 16000;
+	while (duration > MAX_DELAY_US) {
+		delayMicroseconds(MAX_DELAY_US);
+		duration -= MAX_DELAY_US;
+	}
+	delayMicroseconds(static_cast<unsigned int>(duration));
 }
 
-bool AT24CxEeprom::write(const uint16_t address, const uint8_t byte) {
-	ASSERT(address < totalSize());
-
-	size_t i = 0;
-	while (i < WRITE_RETRIES) {
-		mWire.beginTransmission(mAT24CxDeviceAddress);
-
-		// write address
-		mWire.write(highByte(address));
-		mWire.write(lowByte(address));
+class AT24CxEeprom::CallScope {
+public:
+	CallScope(AT24CxEeprom& eeprom) : mEeprom(eeprom), mOutermost(not eeprom.mCallActive) {
+		if (mOutermost) {
+			mEeprom.mCallStart = micros();
+			mEeprom.mCallActive = true;
+		}
+	}
 
-		// write data
-		mWire.write(byte);
-		const ERROR error = static_cast<ERROR>(mWire.endTransmission());
-		if (isNoError(error)) {
-			return true;
+	~CallScope() {
+		if (mOutermost) {
+			mEeprom.mCallActive = false;
 		}
+	}
 
-		++i;
-		delay(1);
+private:
+	AT24CxEeprom& mEeprom;
+	const bool mOutermost;
+};
+
+AT24CxEeprom::Status AT24CxEeprom::toStatus(const ERROR error) {
+	switch (error) {
+	case WIRE_NO_ERROR:
+		return Status::OK;
+	case WIRE_ADDR_TRANSMISSION_NACK:
+		return Status::ADDRESS_NACK;
+	case WIRE_DATA_TRANSMISSION_NACK:
+		return Status::DATA_NACK;
+	case NO_DATA_AVAILABLE:
+		return Status::NO_DATA;
+	case DEADLINE_EXPIRED:
+		return Status::TIMEOUT;
+	default:
+		return Status::BUS_ERROR;
 	}
+}
 
-	return false;
+uint32_t AT24CxEeprom::remainingMicros() const {
+	if (not mCallActive || mRetryPolicy.deadlineMicros == 0) {
+		return NO_DEADLINE;
+	}
+	const uint32_t elapsed = micros() - mCallStart;
+	return (elapsed < mRetryPolicy.deadlineMicros) ? mRetryPolicy.deadlineMicros - elapsed : 0;
 }
 
-bool AT24CxEeprom::read(const uint16_t address, uint8_t &byte) {
-	size_t i = 0;
-	while (i < READ_RETRIES) {
-		mWire.beginTransmission(mAT24CxDeviceAddress);
+bool AT24CxEeprom::asyncDeadlineExpired() const {
+	return (mRetryPolicy.deadlineMicros > 0)
+		&& ((micros() - mAsyncStart) >= mRetryPolicy.deadlineMicros);
+}
 
-		// write address
-		mWire.write(highByte(address));
-		mWire.write(lowByte(address));
+bool AT24CxEeprom::prepareRetry(uint8_t& attempt, ERROR& error) {
+	if (++attempt >= mRetryPolicy.attempts) {
+		return false;
+	}
 
-		const ERROR error = static_cast<ERROR>(mWire.endTransmission());
+	uint32_t backoff = mRetryPolicy.backoffMicros;
+	if (mRetryPolicy.exponentialBackoff) {
+		for (uint8_t i = 1; i < attempt && backoff <= (NO_DEADLINE >> 1); i++) {
+			backoff <<= 1;
+		}
+	}
+	// Don't wait for a repetition that would end after the deadline.
+	if (backoff >= remainingMicros()) {
+		error = DEADLINE_EXPIRED;
+		AT24Cx_STATS(countError(error));
+		return false;
+	}
+	pauseMicros(backoff);
 
-		if (isNoError(error)) {
-			mWire.requestFrom(mAT24CxDeviceAddress, static_cast<uint8_t>(1));
-			if (mWire.available()) {
-				byte = mWire.read();
-			}
-			return true;
+	const ERROR waitError = waitForWriteCycle();
+	if (not isNoError(waitError)) {
+		if (waitError == DEADLINE_EXPIRED) {
+			error = waitError;
 		}
-		++i;
-		delay(1);
+		return false;
 	}
-	return false;
+	AT24Cx_STATS(++mStats.retries);
+	return true;
+}
+
+void AT24CxEeprom::begin() {
+	mTransport.begin();
+}
+
+void AT24CxEeprom::begin(CLOCK_SPEED_HZ speed) {
+	begin();
+	mTransport.setClock(speed);
 }
 
-bool AT24CxEeprom::write(const uint16_t address, const uint8_t *bytes, const size_t count) {
-	uint16_t pageAlignedAddress = address & pageMask();
+AT24CxEeprom::Status AT24CxEeprom::write(const uint32_t address, const uint8_t byte) {
+	ASSERT(address < totalSize());
+	return write(address, &byte, 1);
+}
+
+AT24CxEeprom::Status AT24CxEeprom::read(const uint32_t address, uint8_t &byte) {
+	return read(address, &byte, 1);
+}
+
+AT24CxEeprom::Status AT24CxEeprom::write(const uint32_t address, const uint8_t *bytes, const size_t count) {
+	const CallScope scope(*this);
+	AT24Cx_STATS(const uint32_t start = micros());
+	uint32_t pageAlignedAddress = address & pageMask();
 	uint8_t pageOffset = address & pageOffsetMask();
 
 	size_t i = 0;
@@ -122,11 +189,12 @@ bool AT24CxEeprom::write(const uint16_t address, const uint8_t *bytes, const siz
 		i += n;
 		n = min((count - i), size_t(pageSize()));
 	}
-	return isNoError(error);
+	AT24Cx_STATS(mStats.latency[AT24CxStats::OP_WRITE].record(micros() - start));
+	return toStatus(error);
 }
 
-AT24CxEeprom::ERROR AT24CxEeprom::writeToPage(const uint16_t pageAlignedAddress, const uint8_t pageOffset,
-		const uint8_t *bytes, const size_t count) {
+AT24CxEeprom::ERROR AT24CxEeprom::writeToPage(const uint32_t pageAlignedAddress, const uint8_t pageOffset,
+		const uint8_t *bytes, const size_t count, const bool repeat) {
 
 	ASSERT((pageAlignedAddress & pageOffsetMask()) == 0);
 	ASSERT((static_cast<uint32_t>(pageOffset) + count) <= pageSize());
@@ -137,25 +205,26 @@ AT24CxEeprom::ERROR AT24CxEeprom::writeToPage(const uint16_t pageAlignedAddress,
 	size_t bytesWritten = 0;
 	while (((count - bytesWritten)) > 0 && isNoError(error)) {
 		size_t n = 0;
-		size_t w = 0;
-		while (w < WRITE_RETRIES) {
-			mWire.beginTransmission(mAT24CxDeviceAddress);
-
-			// write address
-			const uint16_t address = pageAlignedAddress + pageOffset + bytesWritten;
-			mWire.write(highByte(address));
-			mWire.write(lowByte(address));
+		uint8_t attempt = 0;
+		for (;;) {
+			if (deadlineExpired()) {
+				error = DEADLINE_EXPIRED;
+				AT24Cx_STATS(countError(error));
+				break;
+			}
 
-			// write data
-			n = mWire.write(&bytes[bytesWritten], count - bytesWritten);
-			error = static_cast<ERROR>(mWire.endTransmission());
+			const uint32_t address = pageAlignedAddress + pageOffset + bytesWritten;
+			const size_t quantity = min(count - bytesWritten, maxBulkWriteQuantity());
+			error = writeTransfer(address, repeat ? bytes : &bytes[bytesWritten], quantity, n, repeat);
 
 			if (isNoError(error)) {
+				error = waitForWriteCycle();
 				break;
 			}
 
-			++w;
-			delay(1);
+			if (not prepareRetry(attempt, error)) {
+				break;
+			}
 		}
 
 		bytesWritten += n;
@@ -164,203 +233,641 @@ AT24CxEeprom::ERROR AT24CxEeprom::writeToPage(const uint16_t pageAlignedAddress,
 	return error;
 }
 
-size_t AT24CxEeprom::maxBulkReadQuantity() const {
-#if defined SERIAL_BUFFER_SIZE
-  return static_cast<size_t>(SERIAL_BUFFER_SIZE);
-#else
-  return sizeMax();
-#endif
-}
+uint8_t AT24CxEeprom::wordAddress(const uint32_t address, uint8_t* bytes) const {
+	uint8_t n = 0;
+	if (mAddressBytes > 1) {
+		bytes[n++] = highByte(address);
+	}
+	bytes[n++] = lowByte(address);
+	return n;
+}
+
+AT24CxEeprom::ERROR AT24CxEeprom::writeTransfer(const uint32_t address, const uint8_t *bytes,
+		const size_t count, size_t &written, const bool repeat) {
+	uint8_t word[2];
+	const uint8_t wordLength = wordAddress(address, word);
+	mTransport.beginTransmission(deviceAddress(address));
+	mTransport.write(word, wordLength);
+
+	// write data
+	if (repeat) {
+		written = 0;
+		while (written < count && mTransport.write(*bytes) == 1) {
+			++written;
+		}
+	} else {
+		written = mTransport.write(bytes, count);
+	}
+	const ERROR error = static_cast<ERROR>(mTransport.endTransmission());
 
-AT24CxEeprom::ERROR AT24CxEeprom::readFromPage(const uint16_t pageAlignedAddress, const uint8_t pageOffset,
-		uint8_t *bytes, const size_t count) {
+	// The address counter of the eeprom has been moved.
+	mCounterValid = false;
 
-	ASSERT((pageAlignedAddress & pageOffsetMask()) == 0);
-	ASSERT((static_cast<uint32_t>(pageOffset) + count) <= pageSize());
-	ASSERT((static_cast<uint32_t>(pageAlignedAddress) + pageSize()) <= totalSize());
+	// Whatever has arrived at the eeprom is no longer valid in the cache.
+	if (mReadCache != nullptr && written > 0) {
+		mReadCache->invalidate(address, written);
+	}
 
-	ERROR error = WIRE_NO_ERROR;
+	AT24Cx_STATS(++mStats.transactions);
+	AT24Cx_STATS(mStats.overheadBytes += DEVICE_ADDRESS_SIZE + addressBytes());
+	AT24Cx_STATS(if (isNoError(error)) {mStats.payloadBytes += written;} else {countError(error);});
+	return error;
+}
 
-	size_t bytesRead = 0;
-	while (((count - bytesRead) > 0) && isNoError(error)) {
-		size_t n = 0;
-		size_t r = 0;
-		while (r < READ_RETRIES) {
-			mWire.beginTransmission(mAT24CxDeviceAddress);
+AT24CxEeprom::ERROR AT24CxEeprom::probe() {
+	mTransport.beginTransmission(mAT24CxDeviceAddress);
+	const ERROR error = static_cast<ERROR>(mTransport.endTransmission());
 
-			// write address
-			const uint16_t address = pageAlignedAddress + pageOffset + bytesRead;
-			mWire.write(highByte(address));
-			mWire.write(lowByte(address));
-			error = static_cast<ERROR>(mWire.endTransmission());
+	AT24Cx_STATS(++mStats.transactions);
+	AT24Cx_STATS(++mStats.ackPolls);
+	AT24Cx_STATS(mStats.overheadBytes += DEVICE_ADDRESS_SIZE);
+	return error;
+}
 
-			if (isNoError(error)) {
-				const size_t i = bytesRead;
-
-				const size_t quantity = min(maxBulkReadQuantity(), count - bytesRead);
-				n = mWire.requestFrom(mAT24CxDeviceAddress, quantity);
-
-				if (mWire.available()) {
-					for (size_t j = 0; j < n; j++) {
-						const int data = mWire.read();
-						ASSERT(data >= 0);
-						bytes[i + j] = lowByte(data);
-					}
-				} else {
-					error = NO_DATA_AVAILABLE;
-				}
+#if AT24CxEepromEnableStats
+void AT24CxEeprom::countError(const ERROR error) {
+	switch (error) {
+	case WIRE_NO_ERROR:
+		break;
+	case WIRE_ADDR_TRANSMISSION_NACK:
+		++mStats.addressNacks;
+		break;
+	case WIRE_DATA_TRANSMISSION_NACK:
+		++mStats.dataNacks;
+		break;
+	case NO_DATA_AVAILABLE:
+		++mStats.noDataAvailable;
+		break;
+	case DEADLINE_EXPIRED:
+		++mStats.timeouts;
+		break;
+	default:
+		++mStats.otherErrors;
+		break;
+	}
+}
 
-				break;
-			}
+void AT24CxEeprom::recordWriteCycle(const uint32_t elapsed) {
+	mStats.busyWaitMicros += elapsed;
+	mStats.latency[AT24CxStats::OP_WRITE_CYCLE].record(elapsed);
+}
+#endif
+
+AT24CxEeprom::ERROR AT24CxEeprom::waitForWriteCycle() {
+	const uint32_t start = micros();
+	const uint32_t timeout = min32(WRITE_CYCLE_TIMEOUT_US, remainingMicros());
+	uint32_t elapsed = 0;
 
-			++r;
-			delay(1);
+	// The eeprom does not acknowledge its device address as long as the
+	// internal write cycle is in progress.
+	for (;;) {
+		const ERROR error = probe();
+		elapsed = micros() - start;
+		if (isNoError(error)) {
+			break;
+		}
+		if (elapsed >= timeout) {
+			const ERROR timeoutError = deadlineExpired() ? DEADLINE_EXPIRED : error;
+			AT24Cx_STATS(mStats.busyWaitMicros += elapsed);
+			AT24Cx_STATS(countError(timeoutError));
+			return timeoutError;
 		}
-		bytesRead += n;
+		delayMicroseconds(ACK_POLL_INTERVAL_US);
 	}
+	AT24Cx_STATS(recordWriteCycle(elapsed));
 
-	return error;
+	if (elapsed > mWriteCycleTime) {
+		mWriteCycleTime = elapsed;
+	}
+	return WIRE_NO_ERROR;
 }
 
-bool AT24CxEeprom::read(const uint16_t address, uint8_t *bytes, const size_t count) {
-	uint16_t pageAlignedAddress = address & pageMask();
-	uint8_t pageOffset = address & pageOffsetMask();
-
-	uint32_t i = 0;
-	uint32_t n = min(count, size_t(pageSize()) - static_cast<size_t>(pageOffset));
+bool AT24CxEeprom::beginWrite(const uint32_t address, const uint8_t *bytes, const size_t count,
+		WriteCallback callback) {
+	ASSERT(address + count <= totalSize());
+	if (isBusy()) {
+		return false;
+	}
+	if (count == 0) {
+		mAsyncSucceeded = true;
+		if (callback) {
+			callback(*this, true);
+		}
+		return true;
+	}
 
-	ERROR error = WIRE_NO_ERROR;
-	while (((count - i) > 0) && isNoError(error)) {
-		error = readFromPage(pageAlignedAddress, pageOffset, &bytes[i], n);
-		pageAlignedAddress += pageSize();
-		pageOffset = 0;
-		i += n;
-		n = min((count - i), uint32_t(pageSize()));
+	mAsyncBytes = bytes;
+	mAsyncCount = count;
+	mAsyncAddress = address;
+	mAsyncRetries = 0;
+	mAsyncStart = micros();
+	mAsyncCallback = callback;
+	mAsyncInProgress = true;
+	mAsyncSucceeded = false;
+	sendAsyncChunk();
+	return true;
+}
+
+void AT24CxEeprom::sendAsyncChunk() {
+	const uint16_t pageOffset = static_cast<uint16_t>(mAsyncAddress & pageOffsetMask());
+	const size_t n = min(min(mAsyncCount, size_t(pageSize()) - static_cast<size_t>(pageOffset)),
+		maxBulkWriteQuantity());
+
+	size_t written = 0;
+	const ERROR error = writeTransfer(mAsyncAddress, mAsyncBytes, n, written);
+	mAsyncCycleStart = micros();
+
+	if (isNoError(error)) {
+		mAsyncBytes += written;
+		mAsyncCount -= written;
+		mAsyncAddress += written;
+		mAsyncRetries = 0;
+	} else if (++mAsyncRetries >= mRetryPolicy.attempts) {
+		completeAsyncWrite(false);
+	}
+	// Otherwise the eeprom is still busy with a write cycle that was not
+	// started by us. tick() will resend the chunk once it has completed.
+}
+
+void AT24CxEeprom::completeAsyncWrite(const bool success) {
+	const WriteCallback callback = mAsyncCallback;
+	mAsyncCount = 0;
+	mAsyncCallback = nullptr;
+	mAsyncInProgress = false;
+	mAsyncSucceeded = success;
+	if (callback) {
+		callback(*this, success);
 	}
-	return isNoError(error);
 }
 
-AT24CxEeprom::AT24CxEeprom(TwoWire& wire, uint8_t deviceAddress)
-		: mAT24CxDeviceAddress((deviceAddress & 0x07) | 0x50), mWire(wire) {
-}
+void AT24CxEeprom::tick() {
+	if (not isBusy()) {
+		return;
+	}
 
-// --- Specific chips
-AT24C01::AT24C01(TwoWire &wire, uint8_t deviceAddress)
-    : AT24CxEeprom(wire, deviceAddress) {
+	const uint32_t elapsed = micros() - mAsyncCycleStart;
+	if (isNoError(probe())) {
+		if (mAsyncRetries == 0 && elapsed > mWriteCycleTime) {
+			mWriteCycleTime = elapsed;
+		}
+		AT24Cx_STATS(recordWriteCycle(elapsed));
+		if (mAsyncCount == 0) {
+			completeAsyncWrite(true);
+		} else if (asyncDeadlineExpired()) {
+			AT24Cx_STATS(++mStats.timeouts);
+			completeAsyncWrite(false);
+		} else {
+			sendAsyncChunk();
+		}
+	} else if (elapsed >= WRITE_CYCLE_TIMEOUT_US) {
+		AT24Cx_STATS(mStats.busyWaitMicros += elapsed);
+		AT24Cx_STATS(++mStats.addressNacks);
+		completeAsyncWrite(false);
+	} else if (asyncDeadlineExpired()) {
+		AT24Cx_STATS(++mStats.timeouts);
+		completeAsyncWrite(false);
+	}
 }
 
-uint32_t AT24C01::totalSize() const {
-  return 0x80;
+size_t AT24CxEeprom::maxBulkReadQuantity() const {
+	return mTransport.maxReadQuantity();
 }
 
-uint32_t AT24C01::pageSize() const {
-  return 8;
+size_t AT24CxEeprom::maxBulkWriteQuantity() const {
+	return mTransport.maxWriteQuantity() - addressBytes();
 }
 
-AT24C02::AT24C02(TwoWire &wire, uint8_t deviceAddress)
-    : AT24CxEeprom(wire, deviceAddress) {
-}
+size_t AT24CxEeprom::expectedWriteCycles(const uint32_t address, const size_t count) const {
+	const size_t quantity = min(maxBulkWriteQuantity(), size_t(pageSize()));
+	uint8_t pageOffset = address & pageOffsetMask();
 
-uint32_t AT24C02::totalSize() const {
-  return 0x100;
-}
+	size_t i = 0;
+	size_t n = min(count, size_t(pageSize()) - static_cast<size_t>(pageOffset));
 
-uint32_t AT24C02::pageSize() const {
-  return 8;
-}
+	size_t cycles = 0;
+	while ((count - i) > 0) {
+		cycles += (n + quantity - 1) / quantity;
+		i += n;
+		n = min((count - i), size_t(pageSize()));
+	}
+	return cycles;
+}
+
+namespace { // anonymous
+
+// Stores the received bytes into a buffer.
+class BufferSink : public AT24CxEeprom::ReadSink {
+public:
+	BufferSink(uint8_t* bytes) : mBytes(bytes) {}
+	void receive(const uint8_t byte) override {*mBytes++ = byte;}
+private:
+	uint8_t* mBytes;
+};
+
+// Compares the received bytes with the expected bytes and records the
+// span of differing bytes.
+class CompareSink : public AT24CxEeprom::ReadSink {
+public:
+	CompareSink(const uint8_t* expected)
+		: mExpected(expected), mIndex(0), mFirstDifference(0), mLastDifference(0), mDiffers(false) {
+	}
 
-AT24C04::AT24C04(TwoWire &wire, uint8_t deviceAddress)
-    : AT24CxEeprom(wire, deviceAddress) {
-}
+	void receive(const uint8_t byte) override {
+		if (byte != mExpected[mIndex]) {
+			if (not mDiffers) {
+				mFirstDifference = mIndex;
+				mDiffers = true;
+			}
+			mLastDifference = mIndex;
+		}
+		++mIndex;
+	}
 
-uint32_t AT24C04::totalSize() const {
-  return 0x200;
-}
+	bool differs() const {return mDiffers;}
+	size_t firstDifference() const {return mFirstDifference;}
+	size_t lastDifference() const {return mLastDifference;}
+
+private:
+	const uint8_t* mExpected;
+	size_t mIndex;
+	size_t mFirstDifference;
+	size_t mLastDifference;
+	bool mDiffers;
+};
+
+// Checks whether all received bytes have the same value.
+class FilledSink : public AT24CxEeprom::ReadSink {
+public:
+	FilledSink(const uint8_t value) : mValue(value), mFilled(true) {}
+	void receive(const uint8_t byte) override {mFilled = mFilled && (byte == mValue);}
+	bool filled() const {return mFilled;}
+private:
+	const uint8_t mValue;
+	bool mFilled;
+};
+
+// Computes the crc of the received bytes.
+class Crc16Sink : public AT24CxEeprom::ReadSink {
+public:
+	Crc16Sink() : mCrc(AT24CxCrc::CRC16_INIT) {}
+	void receive(const uint8_t byte) override {mCrc = AT24CxCrc::crc16(mCrc, byte);}
+	uint16_t crc() const {return mCrc;}
+private:
+	uint16_t mCrc;
+};
+
+class Crc32Sink : public AT24CxEeprom::ReadSink {
+public:
+	Crc32Sink() : mCrc(AT24CxCrc::CRC32_INIT) {}
+	void receive(const uint8_t byte) override {mCrc = AT24CxCrc::crc32(mCrc, byte);}
+	uint32_t crc() const {return AT24CxCrc::crc32Final(mCrc);}
+private:
+	uint32_t mCrc;
+};
+
+} // anonymous namespace
+
+AT24CxEeprom::ERROR AT24CxEeprom::readChunk(const uint32_t address, ReadSink& sink,
+		const size_t count, size_t& bytesRead, const bool continueAtCounter) {
+
+	ASSERT(count <= maxBulkReadQuantity());
+	ASSERT(address < totalSize());
 
-uint32_t AT24C04::pageSize() const {
-  return 16;
-}
+	ERROR error = WIRE_NO_ERROR;
+	bytesRead = 0;
+
+	// If the address counter of the eeprom already points to the address,
+	// the address phase is skipped and the bytes are read from there.
+	bool currentAddress = continueAtCounter && mCounterValid && (mCounter == address);
+	mCounterValid = false;
+
+	uint8_t attempt = 0;
+	for (;;) {
+		if (deadlineExpired()) {
+			error = DEADLINE_EXPIRED;
+			AT24Cx_STATS(countError(error));
+			break;
+		}
 
-AT24C08::AT24C08(TwoWire &wire, uint8_t deviceAddress)
-    : AT24CxEeprom(wire, deviceAddress) {
-}
+		// The word address and the read go to the transport together, so
+		// that it can send them with a repeated START.
+		uint8_t word[2];
+		const uint8_t wordLength = currentAddress ? 0 : wordAddress(address, word);
+		uint8_t wireError = 0;
+		const size_t n = mTransport.requestFrom(deviceAddress(address), word, wordLength, count, wireError);
+		error = static_cast<ERROR>(wireError);
+		if (not currentAddress) {
+			AT24Cx_STATS(++mStats.transactions);
+			AT24Cx_STATS(mStats.overheadBytes += DEVICE_ADDRESS_SIZE + addressBytes());
+		}
+
+		if (isNoError(error)) {
+			AT24Cx_STATS(++mStats.transactions);
+			AT24Cx_STATS(mStats.overheadBytes += DEVICE_ADDRESS_SIZE);
+			AT24Cx_STATS(mStats.payloadBytes += n);
+
+			if (mTransport.available()) {
+				for (size_t j = 0; j < n; j++) {
+					const int data = mTransport.read();
+					ASSERT(data >= 0);
+					sink.receive(lowByte(data));
+				}
+				bytesRead = n;
+				// Whether the counter carries over into the next block is not
+				// specified for all parts, so it is not relied upon.
+				mCounter = (address + n) & addressMask();
+				mCounterValid = ((address + n) & blockOffsetMask()) != 0;
+			} else if (currentAddress) {
+				// Fall back to a read with address phase. This is not counted
+				// as an attempt, it happens at most once.
+				currentAddress = false;
+				AT24Cx_STATS(++mStats.retries);
+				continue;
+			} else {
+				error = NO_DATA_AVAILABLE;
+				AT24Cx_STATS(countError(error));
+			}
 
-uint32_t AT24C08::totalSize() const {
-  return 0x400;
+			break;
+		}
+		AT24Cx_STATS(countError(error));
+
+		if (not prepareRetry(attempt, error)) {
+			break;
+		}
+	}
+
+	return error;
 }
 
-uint32_t AT24C08::pageSize() const {
-  return 16;
+AT24CxEeprom::Status AT24CxEeprom::read(const uint32_t address, ReadSink& sink, const size_t count) {
+	const CallScope scope(*this);
+	// Small reads are served by the read cache, if one is attached.
+	if (mReadCache != nullptr && count <= mReadCache->mLineSize) {
+		return mReadCache->read(address, sink, count);
+	}
+	return readDirect(address, sink, count);
+}
+
+AT24CxEeprom::Status AT24CxEeprom::readDirect(const uint32_t address, ReadSink& sink, const size_t count,
+		const bool continueAtCounter) {
+	const CallScope scope(*this);
+	AT24Cx_STATS(const uint32_t start = micros());
+	// The address counter of the eeprom keeps incrementing across page
+	// boundaries while reading. So the read is only split into chunks that
+	// fit into the receive buffer of the I2C driver, and it wraps around at
+	// the end of the eeprom like the address counter does.
+	// All chunks after the first one continue where the previous one has
+	// stopped, so they are read without address phase. Chunks do not cross
+	// the boundaries of the blocks that are selected by the device address.
+	uint32_t chunkAddress = address;
+	size_t i = 0;
+
+	ERROR error = WIRE_NO_ERROR;
+	while (((count - i) > 0) && isNoError(error)) {
+		size_t n = 0;
+		const size_t blockRemaining = static_cast<size_t>(
+			min32(blockOffsetMask() - (chunkAddress & blockOffsetMask()) + 1, maxBulkReadQuantity()));
+		error = readChunk(chunkAddress, sink, min(blockRemaining, count - i), n,
+			continueAtCounter || (i > 0));
+		chunkAddress = (chunkAddress + n) & addressMask();
+		i += n;
+	}
+	AT24Cx_STATS(mStats.latency[AT24CxStats::OP_READ].record(micros() - start));
+	return toStatus(error);
 }
 
-AT24C16::AT24C16(TwoWire &wire, uint8_t deviceAddress)
-    : AT24CxEeprom(wire, deviceAddress) {
+AT24CxEeprom::Status AT24CxEeprom::read(const uint32_t address, uint8_t *bytes, const size_t count) {
+	BufferSink sink(bytes);
+	return read(address, sink, count);
 }
 
-uint32_t AT24C16::totalSize() const {
-  return 0x800;
+AT24CxEeprom::Status AT24CxEeprom::writeIfChanged(const uint32_t address, const uint8_t *bytes,
+		const size_t count, size_t &pagesWritten) {
+	const CallScope scope(*this);
+	uint32_t pageAlignedAddress = address & pageMask();
+	uint8_t pageOffset = address & pageOffsetMask();
+
+	size_t i = 0;
+	size_t n = min(count, size_t(pageSize()) - static_cast<size_t>(pageOffset));
+
+	pagesWritten = 0;
+	ERROR error = WIRE_NO_ERROR;
+	while (((count - i) > 0) && isNoError(error)) {
+		// Compare the page with the new content while reading it, and only
+		// write the span from the first to the last differing byte.
+		CompareSink compare(&bytes[i]);
+		const Status status = read(pageAlignedAddress + pageOffset, compare, n);
+		if (not status) {
+			return status;
+		}
+		if (compare.differs()) {
+			const size_t first = compare.firstDifference();
+			error = writeToPage(pageAlignedAddress, pageOffset + first, &bytes[i + first],
+				compare.lastDifference() - first + 1);
+			++pagesWritten;
+		}
+		pageAlignedAddress += pageSize();
+		pageOffset = 0;
+		i += n;
+		n = min((count - i), size_t(pageSize()));
+	}
+	return toStatus(error);
 }
 
-uint32_t AT24C16::pageSize() const {
-  return 16;
+AT24CxEeprom::Status AT24CxEeprom::writeIfChanged(const uint32_t address, const uint8_t *bytes,
+		const size_t count) {
+	size_t pagesWritten = 0;
+	return writeIfChanged(address, bytes, count, pagesWritten);
 }
 
-AT24C32::AT24C32(TwoWire &wire, uint8_t deviceAddress)
-		: AT24CxEeprom(wire, deviceAddress) {
+AT24CxEeprom::Status AT24CxEeprom::crcRange(const uint32_t address, const size_t count, uint16_t &crc) {
+	Crc16Sink sink;
+	const Status status = read(address, sink, count);
+	crc = sink.crc();
+	return status;
 }
 
-uint32_t AT24C32::totalSize() const {
-	return 0x1000;
+AT24CxEeprom::Status AT24CxEeprom::crcRange(const uint32_t address, const size_t count, uint32_t &crc) {
+	Crc32Sink sink;
+	const Status status = read(address, sink, count);
+	crc = sink.crc();
+	return status;
 }
 
-uint32_t AT24C32::pageSize() const {
-	return 32;
+AT24CxEeprom::Status AT24CxEeprom::verifyRange(const uint32_t address, const size_t count,
+		const uint32_t expectedCrc) {
+	uint32_t crc = 0;
+	const Status status = crcRange(address, count, crc);
+	if (not status) {
+		return status;
+	}
+	return (crc == expectedCrc) ? Status::OK : Status::MISMATCH;
 }
 
-AT24C64::AT24C64(TwoWire &wire, uint8_t deviceAddress)
-		: AT24CxEeprom(wire, deviceAddress) {
+AT24CxEeprom::Status AT24CxEeprom::verifyRange16(const uint32_t address, const size_t count,
+		const uint16_t expectedCrc) {
+	uint16_t crc = 0;
+	const Status status = crcRange(address, count, crc);
+	if (not status) {
+		return status;
+	}
+	return (crc == expectedCrc) ? Status::OK : Status::MISMATCH;
 }
 
-uint32_t AT24C64::totalSize() const {
-	return 0x2000;
+AT24CxEeprom::Status AT24CxEeprom::autoProbe(const uint32_t scratchAddress, ProbeResult& result) {
+	static const CLOCK_SPEED_HZ speeds[] = {CLK_STANDARD_SPEED, CLK_HIGH_SPEED, CLK_FAST_PLUS};
+	static const uint8_t patterns[] = {0x55, 0xAA, 0x00, 0xFF};
+
+	result.speed = CLK_STANDARD_SPEED;
+	memset(result.errors, 0, sizeof(result.errors));
+
+	begin(CLK_STANDARD_SPEED);
+	uint8_t saved[PROBE_SIZE];
+	BufferSink savedSink(saved);
+	const Status savedStatus = readDirect(scratchAddress, savedSink, PROBE_SIZE);
+	if (not savedStatus) {
+		result.errors[0] = 1;
+		return savedStatus;
+	}
+
+	// Why the probe has failed at CLK_STANDARD_SPEED, if it has.
+	Status status;
+	for (size_t s = 0; s < sizeof(speeds) / sizeof(speeds[0]); s++) {
+		mTransport.setClock(speeds[s]);
+		for (size_t p = 0; p < sizeof(patterns); p++) {
+			// Vary the bytes, so that stuck bits and swapped bytes are detected.
+			uint8_t pattern[PROBE_SIZE];
+			for (uint8_t i = 0; i < PROBE_SIZE; i++) {
+				pattern[i] = patterns[p] ^ static_cast<uint8_t>(i * 0x11);
+			}
+			// The read back must come from the eeprom, not from the read cache.
+			uint8_t readBack[PROBE_SIZE];
+			BufferSink readBackSink(readBack);
+			Status patternStatus = write(scratchAddress, pattern, PROBE_SIZE);
+			if (patternStatus) {
+				patternStatus = readDirect(scratchAddress, readBackSink, PROBE_SIZE);
+			}
+			if (patternStatus && memcmp(pattern, readBack, PROBE_SIZE) != 0) {
+				patternStatus = Status::MISMATCH;
+			}
+			if (not patternStatus) {
+				++result.errors[s];
+				if (s == 0 && status) {
+					status = patternStatus;
+				}
+			}
+		}
+		if (result.errors[s] > 0) {
+			break;
+		}
+		result.speed = speeds[s];
+	}
+
+	// Restore the scratch area at the rate that has been proven to work.
+	mTransport.setClock(result.speed);
+	if (not status) {
+		return status;
+	}
+	return write(scratchAddress, saved, PROBE_SIZE);
 }
 
-uint32_t AT24C64::pageSize() const {
-	return 32;
+AT24CxEeprom::Status AT24CxEeprom::fill(const uint32_t address, const size_t count, const uint8_t value,
+		const bool skipFilledPages) {
+	const CallScope scope(*this);
+	return fillRange(address, count, value, skipFilledPages);
 }
 
-AT24C128::AT24C128(TwoWire &wire, uint8_t deviceAddress)
-		: AT24CxEeprom(wire, deviceAddress) {
+AT24CxEeprom::Status AT24CxEeprom::eraseAll(const bool skipErasedPages) {
+	const CallScope scope(*this);
+	return fillRange(0, totalSize(), 0xFF, skipErasedPages);
 }
 
-uint32_t AT24C128::totalSize() const {
-	return 0x4000;
+AT24CxEeprom::Status AT24CxEeprom::fillRange(const uint32_t address, const uint32_t count, const uint8_t value,
+		const bool skipFilledPages) {
+	ASSERT(address + count <= totalSize());
+
+	uint32_t pageAlignedAddress = address & pageMask();
+	uint8_t pageOffset = address & pageOffsetMask();
+
+	// count may exceed the range of size_t, so it is only narrowed once it
+	// has been limited to a page.
+	uint32_t i = 0;
+	size_t n = static_cast<size_t>(min32(count, pageSize() - pageOffset));
+
+	ERROR error = WIRE_NO_ERROR;
+	while (((count - i) > 0) && isNoError(error)) {
+		bool filled = false;
+		if (skipFilledPages) {
+			FilledSink check(value);
+			const Status status = read(pageAlignedAddress + pageOffset, check, n);
+			if (not status) {
+				return status;
+			}
+			filled = check.filled();
+		}
+		if (not filled) {
+			error = writeToPage(pageAlignedAddress, pageOffset, &value, n, true);
+		}
+		pageAlignedAddress += pageSize();
+		pageOffset = 0;
+		i += n;
+		n = static_cast<size_t>(min32(count - i, pageSize()));
+	}
+	return toStatus(error);
 }
 
-uint32_t AT24C128::pageSize() const {
-	return 64;
+#if defined(ARDUINO)
+AT24CxEeprom::AT24CxEeprom(TwoWire& wire, uint8_t deviceAddress, const uint32_t totalSize,
+	const uint16_t pageSize, const uint8_t addressBytes)
+		: AT24CxEeprom(mWireTransport, deviceAddress, totalSize, pageSize, addressBytes) {
+	mWireTransport = AT24CxTwoWireTransport(&wire);
 }
+#endif
 
-AT24C256::AT24C256(TwoWire &wire, uint8_t deviceAddress)
-		: AT24CxEeprom(wire, deviceAddress) {
+AT24CxEeprom::AT24CxEeprom(AT24CxTransport& transport, uint8_t deviceAddress, const uint32_t totalSize,
+	const uint16_t pageSize, const uint8_t addressBytes)
+		: mAT24CxDeviceAddress((deviceAddress & 0x07) | 0x50),
+#if defined(ARDUINO)
+		  mWireTransport(nullptr),
+#endif
+		  mTransport(transport),
+		  mTotalSize(totalSize), mPageSize(pageSize), mAddressBytes(addressBytes), mWriteCycleTime(0),
+		  mCallStart(0), mCallActive(false),
+		  mReadCache(nullptr), mCounter(0), mCounterValid(false),
+		  mAsyncBytes(nullptr), mAsyncCount(0), mAsyncAddress(0), mAsyncRetries(0),
+		  mAsyncCycleStart(0), mAsyncStart(0), mAsyncCallback(nullptr), mAsyncInProgress(false),
+		  mAsyncSucceeded(true) {
+	// Every write transfer needs room for at least one data byte behind the
+	// word address.
+	ASSERT(mTransport.maxWriteQuantity() > mAddressBytes);
+	// Small parts use the device address bits as block select bits.
+	mAT24CxDeviceAddress &= ~static_cast<uint8_t>(addressMask() >> (8 * mAddressBytes));
+	AT24Cx_STATS(mStats.reset());
 }
 
-uint32_t AT24C256::totalSize() const {
-	return 0x8000;
+AT24CxEeprom::ReadCursor::ReadCursor(AT24CxEeprom& eeprom, const uint32_t address)
+		: mEeprom(eeprom), mPosition(address & eeprom.addressMask()) {
 }
 
-uint32_t AT24C256::pageSize() const {
-	return 64;
+void AT24CxEeprom::ReadCursor::seek(const uint32_t address) {
+	mPosition = address & mEeprom.addressMask();
 }
 
-AT24C512::AT24C512(TwoWire &wire, uint8_t deviceAddress)
-		: AT24CxEeprom(wire, deviceAddress) {
+AT24CxEeprom::Status AT24CxEeprom::ReadCursor::read(uint8_t &byte) {
+	return read(&byte, 1);
 }
 
-uint32_t AT24C512::totalSize() const {
-	return 0x10000;
+AT24CxEeprom::Status AT24CxEeprom::ReadCursor::read(uint8_t *bytes, const size_t count) {
+	BufferSink sink(bytes);
+	return read(sink, count);
 }
 
-uint32_t AT24C512::pageSize() const {
-	return 128;
+AT24CxEeprom::Status AT24CxEeprom::ReadCursor::read(ReadSink& sink, const size_t count) {
+	// The read cache is bypassed, the reads are sequential anyway.
+	const Status status = mEeprom.readDirect(mPosition, sink, count, true);
+	if (status) {
+		mPosition = (mPosition + count) & mEeprom.addressMask();
+	}
+	return status;
 }
@@ -29,16 +29,166 @@
 
 #include <stdint.h>
 #include <stddef.h>
-#include <Wire.h>
+
+#include "AT24CxTransport.h"
+#if defined(ARDUINO)
+#include "AT24CxTwoWireTransport.h"
+#endif
+
+// Set to true to collect bus statistics, see AT24CxEeprom::statsSnapshot().
+// The setting changes the class layout, so it has to be the same for the
+// library and the sketch, i.e. pass it as a build flag.
+#ifndef AT24CxEepromEnableStats
+#define AT24CxEepromEnableStats false
+#endif
+
+#if AT24CxEepromEnableStats
+#include "AT24CxStats.h"
+#endif
+
+class AT24CxReadCacheBase;
 
 class AT24CxEeprom {
 public:
 	enum CLOCK_SPEED_HZ {
 		CLK_STANDARD_SPEED = 100000,
 		CLK_HIGH_SPEED = 400000,
+		CLK_FAST_PLUS = 1000000,
+	};
+
+	/**
+	 * Result of autoProbe().
+	 */
+	struct ProbeResult {
+		// The highest clock rate that has passed the probe without errors.
+		CLOCK_SPEED_HZ speed;
+		// The number of failed transfers and mismatching read backs at
+		// CLK_STANDARD_SPEED, CLK_HIGH_SPEED and CLK_FAST_PLUS. Rates above
+		// the first one with errors are not tried.
+		uint8_t errors[3];
+	};
+
+	/**
+	 * Result of an eeprom operation. It converts to true on success, so it
+	 * can be tested like a bool. code() tells why an operation has failed.
+	 */
+	class Status {
+	public:
+		enum CODE : uint8_t {
+			OK = 0,
+			ADDRESS_NACK,  // device address not acknowledged, e.g. no eeprom or still busy
+			DATA_NACK,     // word address or data byte not acknowledged
+			BUS_ERROR,     // any other error reported by the I2C driver
+			NO_DATA,       // read request answered without data
+			TIMEOUT,       // the deadline of the retry policy has expired
+			MISMATCH,      // the content has been read, but doesn't match the expectation
+		};
+
+		Status(const CODE code = OK) : mCode(code) {}
+		operator bool() const {return mCode == OK;}
+		bool operator==(const CODE code) const {return mCode == code;}
+		bool operator!=(const CODE code) const {return mCode != code;}
+		CODE code() const {return mCode;}
+
+	private:
+		CODE mCode;
+	};
+
+	/**
+	 * How failed transfers are repeated. The default repeats a transfer up
+	 * to 9 times without backoff and without deadline.
+	 */
+	struct RetryPolicy {
+		/**
+		 * @param attempts the number of transfers of the same chunk, including
+		 * the first one. 0 is treated like 1.
+		 * @param backoffMicros pause before the first repetition.
+		 * @param exponentialBackoff if true, the pause doubles with every
+		 * further repetition, otherwise it stays the same.
+		 * @param deadlineMicros time budget of a single call, e.g. of one
+		 * write(), including all write cycles and repetitions. 0 for none.
+		 * A transfer that is in progress when the deadline expires is
+		 * completed, so a call may take up to one transfer longer.
+		 */
+		RetryPolicy(const uint8_t attempts = 10, const uint32_t backoffMicros = 0,
+			const bool exponentialBackoff = false, const uint32_t deadlineMicros = 0)
+				: attempts(attempts), backoffMicros(backoffMicros),
+				  exponentialBackoff(exponentialBackoff), deadlineMicros(deadlineMicros) {
+		}
+
+		uint8_t attempts;
+		uint32_t backoffMicros;
+		bool exponentialBackoff;
+		uint32_t deadlineMicros;
 	};
 
-	AT24CxEeprom(TwoWire& wire, uint8_t deviceAddress /* 0..7 */);
+	/**
+	 * Function that is called when an asynchronous write has completed.
+	 * @param eeprom the eeprom that executed the write.
+	 * @param success true, if all bytes have been written, otherwise false.
+	 */
+	typedef void (*WriteCallback)(AT24CxEeprom& eeprom, bool success);
+
+	/**
+	 * Receiver of the bytes of a read, that consumes the bytes as they come
+	 * in from the I2C bus instead of storing them into a buffer.
+	 */
+	class ReadSink {
+	public:
+		virtual void receive(const uint8_t byte) = 0;
+	protected:
+		~ReadSink() {}
+	};
+
+	/**
+	 * Sequential reader. The first read sets the address counter of the
+	 * eeprom. As long as nothing else moves the counter, every further read
+	 * continues at the counter without sending the address again, i.e. it
+	 * needs a single transfer with a single address byte. After a write or an
+	 * error, the address is sent again. The position wraps around at the end
+	 * of the eeprom like the address counter does.
+	 */
+	class ReadCursor {
+	public:
+		/**
+		 * @param eeprom the eeprom that shall be read.
+		 * @param address eeprom address of the first byte that shall be read.
+		 */
+		ReadCursor(AT24CxEeprom& eeprom, const uint32_t address);
+
+		/**
+		 * Move the cursor.
+		 * @param address eeprom address of the next byte that shall be read.
+		 */
+		void seek(const uint32_t address);
+
+		/**
+		 * get the eeprom address of the next byte that will be read.
+		 */
+		uint32_t position() const {return mPosition;}
+
+		/**
+		 * Read a single byte and advance the cursor.
+		 * @return Status::OK, on success, otherwise the reason of the failure.
+		 */
+		Status read(uint8_t& byte);
+
+		/**
+		 * Read multiple bytes and advance the cursor.
+		 * @return Status::OK, on success, otherwise the reason of the failure.
+		 */
+		Status read(uint8_t* bytes, const size_t count);
+
+		/**
+		 * Read multiple bytes, pass them to a sink and advance the cursor.
+		 * @return Status::OK, on success, otherwise the reason of the failure.
+		 */
+		Status read(ReadSink& sink, const size_t count);
+
+	private:
+		AT24CxEeprom& mEeprom;
+		uint32_t mPosition;
+	};
 
 	/**
 	 * Initialize I2C bus for communication with EEPROM
@@ -55,51 +205,249 @@ public:
 	 */
 	void begin(CLOCK_SPEED_HZ speed);
 
+	/**
+	 * Initialize I2C bus for communication with EEPROM and select the fastest
+	 * clock rate that works. Starting at CLK_STANDARD_SPEED, the clock is
+	 * stepped up through the supported rates. At each rate, test patterns
+	 * are written to a scratch area and read back. The highest rate without
+	 * any error is kept. The previous content of the scratch area is restored.
+	 * @param scratchAddress eeprom address of 8 bytes that may be written
+	 * several times.
+	 * @param result returns the chosen rate and the errors at each rate.
+	 * @return Status::OK, if the eeprom works at least at CLK_STANDARD_SPEED
+	 * and the scratch area has been restored. Status::MISMATCH, if a pattern
+	 * has been read back wrong at CLK_STANDARD_SPEED. Otherwise the status of
+	 * the first failed transfer.
+	 */
+	Status autoProbe(const uint32_t scratchAddress, ProbeResult& result);
+
+	/**
+	 * Set how failed transfers are repeated, see RetryPolicy. Asynchronous
+	 * writes use the attempts and the deadline, but no backoff.
+	 */
+	void setRetryPolicy(const RetryPolicy& policy) {mRetryPolicy = policy;}
+
+	/**
+	 * get the retry policy.
+	 */
+	const RetryPolicy& retryPolicy() const {return mRetryPolicy;}
+
 	/**
 	 * Write a single byte.
 	 * @param address eeprom address where the byte shall be written to.
 	 * @param byte the byte that shall be written.
-	 * @return true, on success, otherwise false.
+	 * @return Status::OK, on success, otherwise the reason of the failure.
 	 */
-	bool write(const uint16_t address, const uint8_t byte);
+	Status write(const uint32_t address, const uint8_t byte);
 
 	/**
 	 * Write multiple bytes.
 	 * @param address eeprom address where the first byte shall be written to.
 	 * @param bytes the bytes that shall be written.
-	 * @return true, on success, otherwise false.
+	 * @return Status::OK, on success, otherwise the reason of the failure.
+	 */
+	Status write(const uint32_t address, const uint8_t* bytes, const size_t count);
+
+	/**
+	 * Write multiple bytes, but only where they differ from the current
+	 * eeprom content. Each affected page is read and compared first. If it
+	 * differs, only the span from the first to the last differing byte of
+	 * the page is written. Unchanged pages are not written at all.
+	 * @param address eeprom address where the first byte shall be written to.
+	 * @param bytes the bytes that shall be written.
+	 * @param pagesWritten returns the number of pages that have actually been written.
+	 * @return Status::OK, on success, otherwise the reason of the failure.
+	 */
+	Status writeIfChanged(const uint32_t address, const uint8_t* bytes, const size_t count,
+		size_t& pagesWritten);
+
+	/**
+	 * Write multiple bytes, but only where they differ from the current
+	 * eeprom content. See above.
+	 * @return Status::OK, on success, otherwise the reason of the failure.
+	 */
+	Status writeIfChanged(const uint32_t address, const uint8_t* bytes, const size_t count);
+
+	/**
+	 * Plan a write without executing it. Each page that the write touches is
+	 * split into as few transfers as the transmit buffer of the I2C driver
+	 * allows, see maxBulkWriteQuantity(), and every transfer costs one
+	 * internal write cycle of the eeprom.
+	 * @param address eeprom address where the first byte would be written to.
+	 * @param count the number of bytes that would be written.
+	 * @return the number of write cycles that write() needs for these bytes.
+	 */
+	size_t expectedWriteCycles(const uint32_t address, const size_t count) const;
+
+	/**
+	 * Fill a range with the same byte value. The value is sent directly to
+	 * the I2C driver, so no buffer is needed.
+	 * @param address eeprom address of the first byte that shall be filled.
+	 * @param count the number of bytes that shall be filled.
+	 * @param value the byte value.
+	 * @param skipFilledPages if true, each page is read first and is only
+	 * written, if it is not yet completely filled with the value.
+	 * @return Status::OK, on success, otherwise the reason of the failure.
+	 */
+	Status fill(const uint32_t address, const size_t count, const uint8_t value,
+		const bool skipFilledPages = false);
+
+	/**
+	 * Erase the whole eeprom, i.e. set all bytes to 0xFF.
+	 * @param skipErasedPages if true, pages that are already erased are not written.
+	 * @return Status::OK, on success, otherwise the reason of the failure.
+	 */
+	Status eraseAll(const bool skipErasedPages = false);
+
+	/**
+	 * Start writing multiple bytes without waiting for the write cycles of the
+	 * eeprom. The bytes are split into the same page aligned chunks as write()
+	 * does. The first chunk is sent immediately, every further chunk is sent by
+	 * tick() as soon as the eeprom has completed the write cycle of the previous
+	 * one.
+	 * @param address eeprom address where the first byte shall be written to.
+	 * @param bytes the bytes that shall be written. They must stay valid until
+	 * the write has completed.
+	 * @param callback function that is called when the write has completed. May be nullptr.
+	 * @return true, if the write has been started, otherwise false. Only one
+	 * asynchronous write can be in progress at a time.
 	 */
-	bool write(const uint16_t address, const uint8_t* bytes, const size_t count);
+	bool beginWrite(const uint32_t address, const uint8_t* bytes, const size_t count,
+		WriteCallback callback = nullptr);
+
+	/**
+	 * Advance an asynchronous write that has been started with beginWrite().
+	 * Never waits for the eeprom, so it is meant to be called repeatedly,
+	 * e.g. from the loop() function.
+	 */
+	void tick();
+
+	/**
+	 * Check whether an asynchronous write is in progress.
+	 * @return true, if an asynchronous write is in progress, otherwise false.
+	 */
+	bool isBusy() const {return mAsyncInProgress;}
+
+	/**
+	 * Check the result of the last asynchronous write.
+	 * @return true, if the last asynchronous write has written all bytes, or
+	 * if none has been started yet. false, if it failed.
+	 */
+	bool asyncWriteSucceeded() const {return mAsyncSucceeded;}
 
 	/**
 	 * Read a single byte.
 	 * @param address eeprom address from where the byte shall be read.
 	 * @param byte the location where the read byte shall be returned.
-	 * @return true, on success, otherwise false.
+	 * @return Status::OK, on success, otherwise the reason of the failure.
 	 */
-	bool read(const uint16_t address, uint8_t& byte);
+	Status read(const uint32_t address, uint8_t& byte);
 
 	/**
 	 * Read a multiple bytes.
 	 * @param address eeprom address from where the first byte shall be read.
 	 * @param bytes the location where the read bytes shall be returned.
-	 * @return true, on success, otherwise false.
+	 * @return Status::OK, on success, otherwise the reason of the failure.
+	 */
+	Status read(const uint32_t address, uint8_t* bytes, const size_t count);
+
+	/**
+	 * Read multiple bytes and pass them to a sink as they are received.
+	 * @param address eeprom address from where the first byte shall be read.
+	 * @param sink the receiver of the read bytes.
+	 * @return Status::OK, on success, otherwise the reason of the failure.
+	 */
+	Status read(const uint32_t address, ReadSink& sink, const size_t count);
+
+	/**
+	 * Compute the CRC-16/CCITT-FALSE of a range while it is read, without a
+	 * buffer. See AT24CxCrc.h.
+	 * @param address eeprom address of the first byte of the range.
+	 * @param crc returns the crc of the range.
+	 * @return Status::OK, on success, otherwise why the range could not be read.
+	 */
+	Status crcRange(const uint32_t address, const size_t count, uint16_t& crc);
+
+	/**
+	 * Compute the CRC-32 of a range while it is read, without a buffer.
+	 * See AT24CxCrc.h.
+	 * @param address eeprom address of the first byte of the range.
+	 * @param crc returns the crc of the range.
+	 * @return Status::OK, on success, otherwise why the range could not be read.
+	 */
+	Status crcRange(const uint32_t address, const size_t count, uint32_t& crc);
+
+	/**
+	 * Check a range against its CRC-32.
+	 * @param address eeprom address of the first byte of the range.
+	 * @param expectedCrc the expected CRC-32 of the range.
+	 * @return Status::OK, if the range has been read and matches the crc,
+	 * Status::MISMATCH, if it has been read but doesn't match, otherwise why
+	 * the range could not be read.
+	 */
+	Status verifyRange(const uint32_t address, const size_t count, const uint32_t expectedCrc);
+
+	/**
+	 * Check a range against its CRC-16/CCITT-FALSE.
+	 * @param address eeprom address of the first byte of the range.
+	 * @param expectedCrc the expected CRC-16 of the range.
+	 * @return Status::OK, if the range has been read and matches the crc,
+	 * Status::MISMATCH, if it has been read but doesn't match, otherwise why
+	 * the range could not be read.
 	 */
-	bool read(const uint16_t address, uint8_t* bytes, const size_t count);
+	Status verifyRange16(const uint32_t address, const size_t count, const uint16_t expectedCrc);
 
 	/**
 	 * get the total size of the eeprom.
 	 * @return the total size of the eeprom in bytes.
 	 */
-	virtual uint32_t totalSize() const = 0;
+	inline uint32_t totalSize() const {return mTotalSize;}
 
 	/**
 	 * get the page size of the eeprom.
 	 * @return the page size of the eeprom in bytes.
 	 */
-	virtual uint32_t pageSize() const = 0;
+	inline uint32_t pageSize() const {return mPageSize;}
+
+	/**
+	 * get the number of word address bytes the eeprom expects.
+	 * @return 1 for the eeproms up to 16 KBit, otherwise 2.
+	 */
+	inline uint8_t addressBytes() const {return mAddressBytes;}
+
+	/**
+	 * get the internal write cycle time of the eeprom, as measured by acknowledge
+	 * polling after each write operation.
+	 * @return the longest write cycle time observed so far in microseconds, or 0
+	 * if no write has been executed yet.
+	 */
+	uint32_t writeCycleTime() const {return mWriteCycleTime;}
+
+#if AT24CxEepromEnableStats
+	/**
+	 * get a copy of the bus statistics collected so far. It can be printed
+	 * to any Print object, e.g. Serial.print(eeprom.statsSnapshot()).
+	 */
+	AT24CxStats statsSnapshot() const {return mStats;}
+
+	/**
+	 * Clear the bus statistics.
+	 */
+	void resetStats() {mStats.reset();}
+#endif
+
+protected:
+#if defined(ARDUINO)
+	AT24CxEeprom(TwoWire& wire, uint8_t deviceAddress /* 0..7 */, const uint32_t totalSize,
+		const uint16_t pageSize, const uint8_t addressBytes);
+#endif
+	AT24CxEeprom(AT24CxTransport& transport, uint8_t deviceAddress /* 0..7 */, const uint32_t totalSize,
+		const uint16_t pageSize, const uint8_t addressBytes);
 
 private:
+	friend class AT24CxReadCacheBase;
+	friend class AT24CxArray;
+
 	enum ERROR : uint8_t {
 		WIRE_NO_ERROR = 0,
 		WIRE_ADDR_TRANSMISSION_NACK = 2,
@@ -108,98 +456,191 @@ private:
 
 		// This is a At24C256eeprom specific ERROR
 		NO_DATA_AVAILABLE,
+		// The deadline of the retry policy has expired.
+		DEADLINE_EXPIRED,
 	};
 
 	inline bool isNoError(const ERROR error)const {
 	  return (error == WIRE_NO_ERROR);
 	}
 
+	static Status toStatus(const ERROR error);
+
 	uint8_t mAT24CxDeviceAddress;
-	TwoWire& mWire;
+#if defined(ARDUINO)
+	// Used when the eeprom is constructed with a TwoWire object.
+	AT24CxTwoWireTransport mWireTransport;
+#endif
+	AT24CxTransport& mTransport;
+
+	// Chip geometry, provided by the AT24Cx template.
+	const uint32_t mTotalSize;
+	const uint16_t mPageSize;
+	const uint8_t mAddressBytes;
+	uint32_t mWriteCycleTime;
+
+	RetryPolicy mRetryPolicy;
+
+	// Start of the outermost public call, for the deadline of the retry
+	// policy. Nested calls run within the deadline of the outermost one.
+	class CallScope;
+	uint32_t mCallStart;
+	bool mCallActive;
+
+#if AT24CxEepromEnableStats
+	AT24CxStats mStats;
+	void countError(const ERROR error);
+	void recordWriteCycle(const uint32_t elapsed);
+#endif
+
+	// Read cache, attached by the AT24CxReadCache constructor.
+	AT24CxReadCacheBase* mReadCache;
+
+	// Address counter of the eeprom, as far as it is known.
+	uint32_t mCounter;
+	bool mCounterValid;
+
+	// State of the asynchronous write.
+	const uint8_t* mAsyncBytes;
+	size_t mAsyncCount;
+	uint32_t mAsyncAddress;
+	uint8_t mAsyncRetries;
+	uint32_t mAsyncCycleStart;
+	uint32_t mAsyncStart;
+	WriteCallback mAsyncCallback;
+	bool mAsyncInProgress;
+	bool mAsyncSucceeded;
 
 	inline uint32_t pageOffsetMask()const {return pageSize()-1;}
 	inline uint32_t pageMask()const {return ~pageOffsetMask();}
+	inline uint32_t addressMask()const {return totalSize()-1;}
 
-	ERROR writeToPage(const uint16_t pageAlignedAddress, const uint8_t pageOffset,
-		const uint8_t* bytes, const size_t count);
+	// The part of an address that is sent as word address. The bits above
+	// select a block by means of the device address.
+	inline uint32_t blockOffsetMask()const {
+		return addressMask() & ((static_cast<uint32_t>(1) << (8 * mAddressBytes)) - 1);
+	}
 
-	ERROR readFromPage(const uint16_t pageAlignedAddress, const uint8_t pageOffset,
-		uint8_t* bytes, const size_t count);
+	inline uint8_t deviceAddress(const uint32_t address)const {
+		return mAT24CxDeviceAddress | static_cast<uint8_t>((address & addressMask()) >> (8 * mAddressBytes));
+	}
 
-	// This limits the number of bytes that are read in one read operation. It can
-	// be overridden by a user defined AT24C - class.
+	// Store the word address, i.e. the low one or two bytes of the address,
+	// most significant first. Returns the number of bytes.
+	uint8_t wordAddress(const uint32_t address, uint8_t* bytes) const;
+
+	// Write to a single page. If repeat is set, bytes points to a single
+	// byte that is written count times.
+	ERROR writeToPage(const uint32_t pageAlignedAddress, const uint8_t pageOffset,
+		const uint8_t* bytes, const size_t count, const bool repeat = false);
+
+	Status fillRange(const uint32_t address, const uint32_t count, const uint8_t value,
+		const bool skipFilledPages);
+
+	// Read from the eeprom, bypassing the read cache. If continueAtCounter
+	// is set, the address phase is skipped when the address counter of the
+	// eeprom already points to the address.
+	Status readDirect(const uint32_t address, ReadSink& sink, const size_t count,
+		const bool continueAtCounter = false);
+
+	// Read at most maxBulkReadQuantity() bytes with a single transfer. Returns
+	// the number of bytes that have been received in bytesRead.
+	ERROR readChunk(const uint32_t address, ReadSink& sink, const size_t count,
+		size_t& bytesRead, const bool continueAtCounter = false);
+
+	// Send one write transfer that must not cross a page boundary. Returns
+	// the number of bytes that have been accepted by the I2C driver in written.
+	ERROR writeTransfer(const uint32_t address, const uint8_t* bytes, const size_t count,
+		size_t& written, const bool repeat = false);
+
+	// Poll the eeprom with its device address until it acknowledges, which
+	// means that the internal write cycle has been completed.
+	ERROR waitForWriteCycle();
+
+	// Probe the eeprom once with its device address.
+	ERROR probe();
+
+	// The time that is left until the deadline of the current call expires.
+	uint32_t remainingMicros() const;
+	inline bool deadlineExpired() const {return remainingMicros() == 0;}
+	bool asyncDeadlineExpired() const;
+
+	// Called after a failed transfer. Waits for the backoff and for the
+	// eeprom to become ready. Returns false, if the transfer shall not be
+	// repeated, because the attempts are used up or the eeprom does not
+	// respond. error is set to DEADLINE_EXPIRED if the deadline is the cause.
+	bool prepareRetry(uint8_t& attempt, ERROR& error);
+
+	// Send the next chunk of the asynchronous write.
+	void sendAsyncChunk();
+	void completeAsyncWrite(const bool success);
+
+	// This limits the number of bytes that are read in one read operation. It is
+	// the receive buffer of the transport. It can be overridden by a user
+	// defined AT24C - class.
 	virtual size_t maxBulkReadQuantity() const;
-};
-
-class AT24C01 : public AT24CxEeprom { // 1 KBit
-public:
-  AT24C01(TwoWire &wire, uint8_t deviceAddress);
-  uint32_t totalSize() const override;
-  uint32_t pageSize() const override;
-};
-
-class AT24C02 : public AT24CxEeprom { // 2 KBit
-public:
-  AT24C02(TwoWire &wire, uint8_t deviceAddress);
-  uint32_t totalSize() const override;
-  uint32_t pageSize() const override;
-};
-
-class AT24C04 : public AT24CxEeprom { // 4 KBit
-public:
-  AT24C04(TwoWire &wire, uint8_t deviceAddress);
-  uint32_t totalSize() const override;
-  uint32_t pageSize() const override;
-};
 
-class AT24C08 : public AT24CxEeprom { // 8 KBit
-public:
-  AT24C08(TwoWire &wire, uint8_t deviceAddress);
-  uint32_t totalSize() const override;
-  uint32_t pageSize() const override;
-};
-
-class AT24C16 : public AT24CxEeprom { // 16 KBit
-public:
-  AT24C16(TwoWire &wire, uint8_t deviceAddress);
-  uint32_t totalSize() const override;
-  uint32_t pageSize() const override;
+	// This limits the number of data bytes that are sent in one write transfer,
+	// i.e. with one write cycle. It is the transmit buffer of the transport
+	// minus the word address. It can be overridden by a user defined AT24C - class.
+	virtual size_t maxBulkWriteQuantity() const;
 };
 
-class AT24C32 : public AT24CxEeprom { // 32 KBit
+/**
+ * An AT24C eeprom with the given geometry.
+ * @tparam TotalSize the total size of the eeprom in bytes.
+ * @tparam PageSize the page size of the eeprom in bytes.
+ * @tparam AddressBytes the number of word address bytes the eeprom expects.
+ */
+template<uint32_t TotalSize, uint16_t PageSize, uint8_t AddressBytes>
+class AT24Cx : public AT24CxEeprom {
 public:
-	AT24C32(TwoWire &wire, uint8_t deviceAddress);
-	uint32_t totalSize() const override;
-	uint32_t pageSize() const override;
-};
-
-class AT24C64 : public AT24CxEeprom { // 64 KBit
-public:
-	AT24C64(TwoWire &wire, uint8_t deviceAddress);
-	uint32_t totalSize() const override;
-private:
-	uint32_t pageSize() const override;
-};
-
-class AT24C128 : public AT24CxEeprom { // 128 KBit
-public:
-	AT24C128(TwoWire &wire, uint8_t deviceAddress);
-	uint32_t totalSize() const override;
-	uint32_t pageSize() const override;
-};
+	static constexpr uint32_t TOTAL_SIZE = TotalSize;
+	static constexpr uint16_t PAGE_SIZE = PageSize;
+	static constexpr uint8_t ADDRESS_BYTES = AddressBytes;
+
+	static_assert((TotalSize & (TotalSize - 1)) == 0, "TotalSize must be a power of 2");
+	static_assert((PageSize & (PageSize - 1)) == 0, "PageSize must be a power of 2");
+	static_assert(PageSize <= TotalSize, "PageSize must not exceed TotalSize");
+	static_assert(AddressBytes == 1 || AddressBytes == 2, "AddressBytes must be 1 or 2");
+	static_assert(PageSize <= 256, "PageSize must not exceed 256");
+	static_assert(TotalSize <= (static_cast<uint32_t>(8) << (8 * AddressBytes)),
+		"At most 3 address bits can be carried in the device address");
+
+#if defined(ARDUINO)
+	AT24Cx(TwoWire &wire, uint8_t deviceAddress /* 0..7 */)
+		: AT24CxEeprom(wire, deviceAddress, TotalSize, PageSize, AddressBytes) {
+	}
+#endif
 
-class AT24C256 : public AT24CxEeprom { // 256 KBit
-public:
-	AT24C256(TwoWire &wire, uint8_t deviceAddress);
-	uint32_t totalSize() const override;
-	uint32_t pageSize() const override;
+	/**
+	 * Construct an eeprom on another bus, e.g. AT24CxLinuxI2cTransport.
+	 * The transport must outlive the eeprom.
+	 */
+	AT24Cx(AT24CxTransport &transport, uint8_t deviceAddress /* 0..7 */)
+		: AT24CxEeprom(transport, deviceAddress, TotalSize, PageSize, AddressBytes) {
+	}
 };
 
-class AT24C512 : public AT24CxEeprom { // 512 KBit
-public:
-	AT24C512(TwoWire &wire, uint8_t deviceAddress);
-	uint32_t totalSize() const override;
-	uint32_t pageSize() const override;
-};
+template<uint32_t TotalSize, uint16_t PageSize, uint8_t AddressBytes>
+constexpr uint32_t AT24Cx<TotalSize, PageSize, AddressBytes>::TOTAL_SIZE;
+template<uint32_t TotalSize, uint16_t PageSize, uint8_t AddressBytes>
+constexpr uint16_t AT24Cx<TotalSize, PageSize, AddressBytes>::PAGE_SIZE;
+template<uint32_t TotalSize, uint16_t PageSize, uint8_t AddressBytes>
+constexpr uint8_t AT24Cx<TotalSize, PageSize, AddressBytes>::ADDRESS_BYTES;
+
+// --- Specific chips
+typedef AT24Cx<0x80,    8,   1> AT24C01;  // 1 KBit
+typedef AT24Cx<0x100,   8,   1> AT24C02;  // 2 KBit
+typedef AT24Cx<0x200,   16,  1> AT24C04;  // 4 KBit
+typedef AT24Cx<0x400,   16,  1> AT24C08;  // 8 KBit
+typedef AT24Cx<0x800,   16,  1> AT24C16;  // 16 KBit
+typedef AT24Cx<0x1000,  32,  2> AT24C32;  // 32 KBit
+typedef AT24Cx<0x2000,  32,  2> AT24C64;  // 64 KBit
+typedef AT24Cx<0x4000,  64,  2> AT24C128; // 128 KBit
+typedef AT24Cx<0x8000,  64,  2> AT24C256; // 256 KBit
+typedef AT24Cx<0x10000, 128, 2> AT24C512; // 512 KBit
+typedef AT24Cx<0x20000, 256, 2> AT24CM01; // 1 MBit
+typedef AT24Cx<0x40000, 256, 2> AT24CM02; // 2 MBit
 
 #endif /* AT24Cx_HPP_ */
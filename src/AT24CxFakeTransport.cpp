@@ -0,0 +1,165 @@
+/*
+  AT24eeprom - Arduino libary for driving the AT24 I2 based eeproms Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/AT24eeprom/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#define ASSERT assert
+
+#include "AT24CxFakeTransport.h"
+
+// Error codes of the transport interface.
+static constexpr uint8_t NO_ERROR = 0;
+static constexpr uint8_t ADDRESS_NACK = 2;
+
+AT24CxFakeTransportBase::AT24CxFakeTransportBase(uint8_t* memory, uint8_t* buffer, const uint32_t totalSize,
+	const uint16_t pageSize, const uint8_t addressBytes, const uint8_t deviceAddress,
+	const size_t bufferLength)
+		: mMemory(memory), mBuffer(buffer), mTotalSize(totalSize), mPageSize(pageSize),
+		  mAddressBytes(addressBytes), mDeviceAddress((deviceAddress & 0x07) | 0x50),
+		  mBufferLength(bufferLength), mClock(100000), mCounter(0),
+		  mTxAddress(0), mTxLength(0), mRxAddress(0), mRxLength(0),
+		  mBusyPolls(0), mWriteCyclePolls(1), mInjectedError(NO_ERROR), mInjectedErrors(0),
+		  mWriteTransfers(0), mReadTransfers(0), mWriteCycles(0) {
+	// Small parts use the address pins as block select bits.
+	mDeviceAddress &= ~blockMask();
+	erase();
+}
+
+void AT24CxFakeTransportBase::erase(const uint8_t value) {
+	memset(mMemory, value, mTotalSize);
+}
+
+void AT24CxFakeTransportBase::injectErrors(const uint8_t error, const uint16_t count) {
+	mInjectedError = error;
+	mInjectedErrors = count;
+}
+
+void AT24CxFakeTransportBase::beginTransmission(const uint8_t deviceAddress) {
+	mTxAddress = deviceAddress;
+	mTxLength = 0;
+}
+
+size_t AT24CxFakeTransportBase::write(const uint8_t byte) {
+	if (mTxLength >= mBufferLength) {
+		return 0;
+	}
+	mBuffer[mTxLength++] = byte;
+	return 1;
+}
+
+size_t AT24CxFakeTransportBase::write(const uint8_t* bytes, const size_t count) {
+	size_t n = 0;
+	while (n < count && write(bytes[n]) == 1) {
+		++n;
+	}
+	return n;
+}
+
+uint8_t AT24CxFakeTransportBase::endTransmission() {
+	return transfer(mTxAddress, mBuffer, mTxLength);
+}
+
+uint8_t AT24CxFakeTransportBase::select(const uint8_t deviceAddress) {
+	if (mInjectedErrors > 0) {
+		--mInjectedErrors;
+		return mInjectedError;
+	}
+	if ((deviceAddress & ~blockMask()) != mDeviceAddress) {
+		return ADDRESS_NACK;
+	}
+	if (mBusyPolls > 0) {
+		--mBusyPolls;
+		return ADDRESS_NACK;
+	}
+	return NO_ERROR;
+}
+
+uint8_t AT24CxFakeTransportBase::transfer(const uint8_t deviceAddress, const uint8_t* bytes,
+		const size_t count) {
+	++mWriteTransfers;
+	const uint8_t error = select(deviceAddress);
+	if (error != NO_ERROR || count == 0) {
+		return error;
+	}
+
+	// The block select bits and the word address set the address counter.
+	uint32_t address = static_cast<uint32_t>(deviceAddress & blockMask()) << (8 * mAddressBytes);
+	const size_t wordLength = (count < mAddressBytes) ? count : mAddressBytes;
+	for (size_t i = 0; i < wordLength; i++) {
+		address |= static_cast<uint32_t>(bytes[i]) << (8 * (mAddressBytes - 1 - i));
+	}
+	mCounter = address & addressMask();
+
+	// Data rolls over within the page.
+	if (count > wordLength) {
+		const uint32_t pageAlignedAddress = mCounter & ~static_cast<uint32_t>(mPageSize - 1);
+		uint32_t offset = mCounter - pageAlignedAddress;
+		for (size_t i = wordLength; i < count; i++) {
+			mMemory[pageAlignedAddress + offset] = bytes[i];
+			offset = (offset + 1) & (mPageSize - 1);
+		}
+		mCounter = pageAlignedAddress + offset;
+		mBusyPolls = mWriteCyclePolls;
+		++mWriteCycles;
+	}
+	return NO_ERROR;
+}
+
+size_t AT24CxFakeTransportBase::requestFrom(const uint8_t deviceAddress, const uint8_t* wordAddress,
+		const uint8_t wordAddressLength, const size_t count, uint8_t& error) {
+	ASSERT(wordAddressLength <= mAddressBytes);
+	mRxLength = 0;
+	error = NO_ERROR;
+	if (wordAddressLength > 0) {
+		error = transfer(deviceAddress, wordAddress, wordAddressLength);
+		if (error != NO_ERROR) {
+			return 0;
+		}
+	}
+
+	++mReadTransfers;
+	if (select(deviceAddress) != NO_ERROR) {
+		// The driver reports a NACK of a read as an empty read.
+		return 0;
+	}
+	mRxAddress = mCounter;
+	mRxLength = (count < mBufferLength) ? count : mBufferLength;
+	mCounter = (mCounter + mRxLength) & addressMask();
+	return mRxLength;
+}
+
+int AT24CxFakeTransportBase::available() {
+	return static_cast<int>(mRxLength);
+}
+
+int AT24CxFakeTransportBase::read() {
+	if (mRxLength == 0) {
+		return -1;
+	}
+	const uint8_t byte = mMemory[mRxAddress];
+	mRxAddress = (mRxAddress + 1) & addressMask();
+	--mRxLength;
+	return byte;
+}
@@ -0,0 +1,172 @@
+/*
+  AT24eeprom - Arduino libary for driving the AT24 I2 based eeproms Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/AT24eeprom/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+#pragma once
+
+#ifndef AT24CxFakeTransport_HPP_
+#define AT24CxFakeTransport_HPP_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "AT24CxTransport.h"
+
+/**
+ * Transport that emulates a single AT24C eeprom in RAM, for tests without
+ * hardware. It models the address counter, the roll over of page writes,
+ * the block select bits in the device address and a write cycle during
+ * which the eeprom does not acknowledge its device address. Errors can be
+ * injected into the following transfers.
+ *
+ * Use the AT24CxFakeTransport template to get a transport with its own
+ * memory, e.g. AT24CxFakeTransport<AT24C256> bus; AT24C256 eeprom(bus, 0);
+ */
+class AT24CxFakeTransportBase : public AT24CxTransport {
+public:
+	void begin() override {}
+	void setClock(const uint32_t clock) override {mClock = clock;}
+	void beginTransmission(const uint8_t deviceAddress) override;
+	size_t write(const uint8_t byte) override;
+	size_t write(const uint8_t* bytes, const size_t count) override;
+	uint8_t endTransmission() override;
+	size_t requestFrom(const uint8_t deviceAddress, const uint8_t* wordAddress,
+		const uint8_t wordAddressLength, const size_t count, uint8_t& error) override;
+	int available() override;
+	int read() override;
+	size_t maxWriteQuantity() const override {return mBufferLength;}
+	size_t maxReadQuantity() const override {return mBufferLength;}
+
+	/**
+	 * Let the following transfers fail.
+	 * @param error the error code, 2 for an address NACK, 3 for a data NACK
+	 * or 4 for another bus error.
+	 * @param count the number of transfers that fail.
+	 */
+	void injectErrors(const uint8_t error, const uint16_t count);
+
+	/**
+	 * Set the number of address transfers that the eeprom does not
+	 * acknowledge after a write, i.e. the duration of the write cycle.
+	 */
+	void setWriteCyclePolls(const uint16_t polls) {mWriteCyclePolls = polls;}
+
+	/**
+	 * Fill the memory without bus transfers.
+	 */
+	void erase(const uint8_t value = 0xFF);
+
+	/**
+	 * get the memory of the emulated eeprom.
+	 */
+	uint8_t* memory() const {return mMemory;}
+
+	/**
+	 * get the clock rate set by the last setClock().
+	 */
+	uint32_t clock() const {return mClock;}
+
+	/**
+	 * get the number of write transfers, including those with the word
+	 * address of a read and the probes.
+	 */
+	uint32_t writeTransfers() const {return mWriteTransfers;}
+
+	/**
+	 * get the number of read transfers.
+	 */
+	uint32_t readTransfers() const {return mReadTransfers;}
+
+	/**
+	 * get the number of write cycles, i.e. of write transfers with data.
+	 */
+	uint32_t writeCycles() const {return mWriteCycles;}
+
+protected:
+	AT24CxFakeTransportBase(uint8_t* memory, uint8_t* buffer, const uint32_t totalSize,
+		const uint16_t pageSize, const uint8_t addressBytes, const uint8_t deviceAddress,
+		const size_t bufferLength);
+	~AT24CxFakeTransportBase() {}
+
+private:
+	uint8_t* const mMemory;
+	uint8_t* const mBuffer;
+	const uint32_t mTotalSize;
+	const uint16_t mPageSize;
+	const uint8_t mAddressBytes;
+	uint8_t mDeviceAddress;
+	const size_t mBufferLength;
+
+	uint32_t mClock;
+	uint32_t mCounter;
+
+	// Pending write transfer.
+	uint8_t mTxAddress;
+	size_t mTxLength;
+
+	// Bytes of the last read that have not been fetched yet.
+	uint32_t mRxAddress;
+	size_t mRxLength;
+
+	uint16_t mBusyPolls;
+	uint16_t mWriteCyclePolls;
+	uint8_t mInjectedError;
+	uint16_t mInjectedErrors;
+
+	uint32_t mWriteTransfers;
+	uint32_t mReadTransfers;
+	uint32_t mWriteCycles;
+
+	inline uint32_t addressMask() const {return mTotalSize - 1;}
+	inline uint8_t blockMask() const {
+		return static_cast<uint8_t>(addressMask() >> (8 * mAddressBytes));
+	}
+
+	// Address the eeprom. Returns the error code of the device address.
+	uint8_t select(const uint8_t deviceAddress);
+
+	// Execute a write transfer with the word address and data in bytes.
+	uint8_t transfer(const uint8_t deviceAddress, const uint8_t* bytes, const size_t count);
+};
+
+/**
+ * Fake transport with an eeprom of type CHIP, e.g. AT24C256, with the
+ * address pins deviceAddress and a transfer buffer of BufferLength bytes,
+ * like the 32 bytes of the AVR TwoWire driver.
+ */
+template<class CHIP, size_t BufferLength = 32>
+class AT24CxFakeTransport : public AT24CxFakeTransportBase {
+public:
+	static_assert(BufferLength > CHIP::ADDRESS_BYTES, "BufferLength must exceed the word address");
+
+	AT24CxFakeTransport(const uint8_t deviceAddress = 0 /* 0..7 */)
+		: AT24CxFakeTransportBase(mMemoryStorage, mBufferStorage, CHIP::TOTAL_SIZE, CHIP::PAGE_SIZE,
+			CHIP::ADDRESS_BYTES, deviceAddress, BufferLength) {
+	}
+
+private:
+	uint8_t mMemoryStorage[CHIP::TOTAL_SIZE];
+	uint8_t mBufferStorage[BufferLength];
+};
+
+#endif /* AT24CxFakeTransport_HPP_ */
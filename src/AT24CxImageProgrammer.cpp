@@ -0,0 +1,374 @@
+/*
+  AT24eeprom - Arduino libary for driving the AT24 I2 based eeproms Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/AT24eeprom/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#define ASSERT assert
+
+#include "AT24CxImageProgrammer.h"
+
+// Intel HEX record types.
+static constexpr uint8_t HEX_DATA = 0x00;
+static constexpr uint8_t HEX_END_OF_FILE = 0x01;
+static constexpr uint8_t HEX_EXTENDED_SEGMENT_ADDRESS = 0x02;
+static constexpr uint8_t HEX_START_SEGMENT_ADDRESS = 0x03;
+static constexpr uint8_t HEX_EXTENDED_LINEAR_ADDRESS = 0x04;
+static constexpr uint8_t HEX_START_LINEAR_ADDRESS = 0x05;
+
+// Byte count, address and record type.
+static constexpr uint8_t HEX_HEADER_SIZE = 4;
+
+static inline bool isCovered(const uint8_t* covered, const size_t i) {
+	return (covered[i / 8] >> (i % 8)) & 1;
+}
+
+static bool hexDigit(const uint8_t c, uint8_t& value) {
+	if (c >= '0' && c <= '9') {
+		value = c - '0';
+	} else if (c >= 'A' && c <= 'F') {
+		value = c - 'A' + 10;
+	} else if (c >= 'a' && c <= 'f') {
+		value = c - 'a' + 10;
+	} else {
+		return false;
+	}
+	return true;
+}
+
+namespace { // anonymous
+
+// Compares the received bytes with the covered bytes of the page and
+// fills in the bytes that are not covered.
+class MergeSink : public AT24CxEeprom::ReadSink {
+public:
+	MergeSink(uint8_t* data, const uint8_t* covered)
+		: mData(data), mCovered(covered), mIndex(0), mFirst(0), mLast(0), mDiffers(false) {
+	}
+
+	void receive(const uint8_t byte) override {
+		if (not isCovered(mCovered, mIndex)) {
+			mData[mIndex] = byte;
+		} else if (mData[mIndex] != byte) {
+			if (not mDiffers) {
+				mFirst = mIndex;
+				mDiffers = true;
+			}
+			mLast = mIndex;
+		}
+		++mIndex;
+	}
+
+	bool differs() const {return mDiffers;}
+	size_t first() const {return mFirst;}
+	size_t last() const {return mLast;}
+
+private:
+	uint8_t* const mData;
+	const uint8_t* const mCovered;
+	size_t mIndex;
+	size_t mFirst;
+	size_t mLast;
+	bool mDiffers;
+};
+
+// Checks whether the received bytes match the expected bytes.
+class VerifySink : public AT24CxEeprom::ReadSink {
+public:
+	VerifySink(const uint8_t* expected) : mExpected(expected), mMatches(true) {}
+	void receive(const uint8_t byte) override {mMatches = mMatches && (byte == *mExpected++);}
+	bool matches() const {return mMatches;}
+private:
+	const uint8_t* mExpected;
+	bool mMatches;
+};
+
+} // anonymous namespace
+
+AT24CxImageProgrammerBase::AT24CxImageProgrammerBase(AT24CxEeprom& eeprom, Page* pages, uint8_t* data,
+	uint8_t* covered, const size_t pageSize, uint8_t* record, const size_t recordSize)
+		: mEeprom(eeprom), mPages(pages), mPageSize(pageSize), mRecord(record), mRecordSize(recordSize),
+		  mPageReport(nullptr), mTimeoutMillis(1000), mInput(nullptr), mReceiving(0), mWriting(false),
+		  mPageFailed(false), mPagesUnchanged(0), mPagesProgrammed(0), mPagesFailed(0) {
+	ASSERT(pageSize == eeprom.pageSize());
+	for (size_t i = 0; i < 2; i++) {
+		mPages[i].data = &data[i * pageSize];
+		mPages[i].covered = &covered[i * ((pageSize + 7) / 8)];
+		mPages[i].valid = false;
+	}
+}
+
+void AT24CxImageProgrammerBase::start(Stream& input) {
+	mInput = &input;
+	mPages[0].valid = false;
+	mPages[1].valid = false;
+	mReceiving = 0;
+	mWriting = false;
+	mPageFailed = false;
+	mPagesUnchanged = 0;
+	mPagesProgrammed = 0;
+	mPagesFailed = 0;
+}
+
+AT24CxImageProgrammerBase::RESULT AT24CxImageProgrammerBase::finish(const RESULT result) {
+	if (mPages[mReceiving].valid) {
+		closePage();
+	}
+	completeWrite();
+	mInput = nullptr;
+	return (result == IMAGE_OK && mPageFailed) ? IMAGE_PAGE_FAILED : result;
+}
+
+bool AT24CxImageProgrammerBase::nextByte(uint8_t& byte) {
+	// The write of the previous page is advanced with every byte, also if
+	// the bytes are already waiting in the receive buffer of the stream.
+	const uint32_t start = millis();
+	for (;;) {
+		mEeprom.tick();
+		if (mInput->available() > 0) {
+			break;
+		}
+		if ((millis() - start) >= mTimeoutMillis) {
+			return false;
+		}
+	}
+	const int c = mInput->read();
+	if (c < 0) {
+		return false;
+	}
+	byte = static_cast<uint8_t>(c);
+	return true;
+}
+
+AT24CxImageProgrammerBase::RESULT AT24CxImageProgrammerBase::nextHexByte(uint8_t& byte,
+		uint8_t& checksum) {
+	uint8_t digits[2];
+	for (uint8_t i = 0; i < 2; i++) {
+		uint8_t c = 0;
+		if (not nextByte(c)) {
+			return IMAGE_TIMEOUT;
+		}
+		if (not hexDigit(c, digits[i])) {
+			return IMAGE_FORMAT_ERROR;
+		}
+	}
+	byte = static_cast<uint8_t>((digits[0] << 4) | digits[1]);
+	checksum += byte;
+	return IMAGE_OK;
+}
+
+void AT24CxImageProgrammerBase::report(const Page& page, const PAGE_RESULT result) {
+	switch (result) {
+	case PAGE_UNCHANGED:
+		++mPagesUnchanged;
+		break;
+	case PAGE_PROGRAMMED:
+		++mPagesProgrammed;
+		break;
+	default:
+		++mPagesFailed;
+		mPageFailed = true;
+		break;
+	}
+	if (mPageReport) {
+		mPageReport(page.address, result);
+	}
+}
+
+void AT24CxImageProgrammerBase::completeWrite() {
+	if (not mWriting) {
+		return;
+	}
+	mWriting = false;
+
+	Page& page = mPages[mReceiving ^ 1];
+	while (mEeprom.isBusy()) {
+		mEeprom.tick();
+	}
+
+	if (not mEeprom.asyncWriteSucceeded()) {
+		report(page, PAGE_WRITE_FAILED);
+	} else {
+		VerifySink verify(&page.data[page.first]);
+		if (not mEeprom.read(page.address + page.first, verify, page.end - page.first)) {
+			report(page, PAGE_READ_FAILED);
+		} else {
+			report(page, verify.matches() ? PAGE_PROGRAMMED : PAGE_VERIFY_FAILED);
+		}
+	}
+	page.valid = false;
+}
+
+void AT24CxImageProgrammerBase::closePage() {
+	Page& page = mPages[mReceiving];
+
+	// The previous page must have been written before it can be verified,
+	// and before the eeprom can be read again.
+	completeWrite();
+
+	MergeSink merge(page.data, page.covered);
+	if (not mEeprom.read(page.address, merge, mPageSize)) {
+		report(page, PAGE_READ_FAILED);
+		page.valid = false;
+		return;
+	}
+	if (not merge.differs()) {
+		report(page, PAGE_UNCHANGED);
+		page.valid = false;
+		return;
+	}
+
+	page.first = static_cast<uint16_t>(merge.first());
+	page.end = static_cast<uint16_t>(merge.last() + 1);
+	if (not mEeprom.beginWrite(page.address + page.first, &page.data[page.first], page.end - page.first)) {
+		report(page, PAGE_WRITE_FAILED);
+		page.valid = false;
+		return;
+	}
+
+	// Receive the next page into the other buffer while this one is written.
+	mWriting = true;
+	mReceiving ^= 1;
+	mPages[mReceiving].valid = false;
+}
+
+AT24CxImageProgrammerBase::RESULT AT24CxImageProgrammerBase::place(const uint32_t address,
+		const uint8_t byte) {
+	if (address >= mEeprom.totalSize()) {
+		return IMAGE_OUT_OF_RANGE;
+	}
+
+	const uint32_t pageAddress = address & ~static_cast<uint32_t>(mPageSize - 1);
+	if (mPages[mReceiving].valid && mPages[mReceiving].address != pageAddress) {
+		closePage();
+	}
+
+	Page& page = mPages[mReceiving];
+	if (not page.valid) {
+		page.address = pageAddress;
+		memset(page.covered, 0, (mPageSize + 7) / 8);
+		page.valid = true;
+	}
+	const size_t i = address - pageAddress;
+	page.data[i] = byte;
+	page.covered[i / 8] |= static_cast<uint8_t>(1 << (i % 8));
+	return IMAGE_OK;
+}
+
+AT24CxImageProgrammerBase::RESULT AT24CxImageProgrammerBase::programBinary(Stream& input,
+		const uint32_t address, const uint32_t length) {
+	start(input);
+	if (address > mEeprom.totalSize() || length > mEeprom.totalSize() - address) {
+		return finish(IMAGE_OUT_OF_RANGE);
+	}
+
+	for (uint32_t i = 0; i < length; i++) {
+		uint8_t byte = 0;
+		if (not nextByte(byte)) {
+			return finish(IMAGE_TIMEOUT);
+		}
+		place(address + i, byte);
+	}
+	return finish(IMAGE_OK);
+}
+
+AT24CxImageProgrammerBase::RESULT AT24CxImageProgrammerBase::programHex(Stream& input) {
+	start(input);
+	uint32_t baseAddress = 0;
+
+	for (;;) {
+		// Skip the line ends and white space up to the start code of the record.
+		uint8_t c = 0;
+		do {
+			if (not nextByte(c)) {
+				return finish(IMAGE_TIMEOUT);
+			}
+		} while (c == '\r' || c == '\n' || c == ' ' || c == '\t');
+		if (c != ':') {
+			return finish(IMAGE_FORMAT_ERROR);
+		}
+
+		// The record is only programmed once its checksum has been checked.
+		uint8_t checksum = 0;
+		uint8_t header[HEX_HEADER_SIZE];
+		RESULT result = IMAGE_OK;
+		for (uint8_t i = 0; i < HEX_HEADER_SIZE && result == IMAGE_OK; i++) {
+			result = nextHexByte(header[i], checksum);
+		}
+		if (result != IMAGE_OK) {
+			return finish(result);
+		}
+		const uint8_t length = header[0];
+		const uint16_t offset = static_cast<uint16_t>((static_cast<uint16_t>(header[1]) << 8) | header[2]);
+		const uint8_t type = header[3];
+		if (length > mRecordSize) {
+			return finish(IMAGE_FORMAT_ERROR);
+		}
+		for (uint8_t i = 0; i < length && result == IMAGE_OK; i++) {
+			result = nextHexByte(mRecord[i], checksum);
+		}
+		uint8_t recordChecksum = 0;
+		if (result == IMAGE_OK) {
+			result = nextHexByte(recordChecksum, checksum);
+		}
+		if (result != IMAGE_OK) {
+			return finish(result);
+		}
+		if (checksum != 0) {
+			return finish(IMAGE_CHECKSUM_ERROR);
+		}
+
+		switch (type) {
+		case HEX_DATA:
+			// A record that doesn't fit is rejected before any of its bytes
+			// is placed, so none of them is programmed.
+			if (baseAddress > mEeprom.totalSize()
+					|| static_cast<uint32_t>(offset) + length > mEeprom.totalSize() - baseAddress) {
+				return finish(IMAGE_OUT_OF_RANGE);
+			}
+			for (uint8_t i = 0; i < length && result == IMAGE_OK; i++) {
+				result = place(baseAddress + offset + i, mRecord[i]);
+			}
+			if (result != IMAGE_OK) {
+				return finish(result);
+			}
+			break;
+		case HEX_END_OF_FILE:
+			return finish(IMAGE_OK);
+		case HEX_EXTENDED_SEGMENT_ADDRESS:
+		case HEX_EXTENDED_LINEAR_ADDRESS:
+			if (length != 2) {
+				return finish(IMAGE_FORMAT_ERROR);
+			}
+			baseAddress = static_cast<uint32_t>((static_cast<uint16_t>(mRecord[0]) << 8) | mRecord[1])
+				<< ((type == HEX_EXTENDED_SEGMENT_ADDRESS) ? 4 : 16);
+			break;
+		case HEX_START_SEGMENT_ADDRESS:
+		case HEX_START_LINEAR_ADDRESS:
+			break;
+		default:
+			return finish(IMAGE_FORMAT_ERROR);
+		}
+	}
+}
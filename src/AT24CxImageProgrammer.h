@@ -0,0 +1,201 @@
+/*
+  AT24eeprom - Arduino libary for driving the AT24 I2 based eeproms Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/AT24eeprom/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+#pragma once
+
+#ifndef AT24CxImageProgrammer_HPP_
+#define AT24CxImageProgrammer_HPP_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include <Arduino.h>
+
+#include "AT24CxEeprom.h"
+
+/**
+ * Programs an image that is received from a Stream, e.g. Serial, into an
+ * eeprom. The image is either raw binary or Intel HEX.
+ *
+ * The received bytes are collected page by page. When a page is complete,
+ * it is read from the eeprom once. The read serves two purposes:
+ * - It compares the page with the image. Pages that already match are not written.
+ * - It fills in the bytes of the page that the image does not cover.
+ * Otherwise the span from the first to the last differing byte is written
+ * with an asynchronous write. While the eeprom is busy with its write
+ * cycle, the next page is received. Before the next page is handled, the
+ * written span is read back and compared. So every page is read once and
+ * written and verified at most once.
+ *
+ * The result of each page can be reported to a callback.
+ *
+ * Use the AT24CxImageProgrammer template to get a programmer with its own buffers.
+ */
+class AT24CxImageProgrammerBase {
+public:
+	enum PAGE_RESULT : uint8_t {
+		PAGE_UNCHANGED = 0,  // the page already matched the image and has not been written
+		PAGE_PROGRAMMED,     // the page has been written and verified
+		PAGE_READ_FAILED,    // the page could not be read for the comparison
+		PAGE_WRITE_FAILED,   // the write of the page has failed
+		PAGE_VERIFY_FAILED,  // the page has been written, but the read back differs
+	};
+
+	enum RESULT : uint8_t {
+		IMAGE_OK = 0,          // all pages match the image
+		IMAGE_PAGE_FAILED,     // at least one page could not be programmed
+		IMAGE_FORMAT_ERROR,    // malformed Intel HEX record
+		IMAGE_CHECKSUM_ERROR,  // Intel HEX record with wrong checksum
+		IMAGE_TIMEOUT,         // the stream has not delivered the next byte in time
+		IMAGE_OUT_OF_RANGE,    // the image exceeds the eeprom
+	};
+
+	/**
+	 * Function that is called when a page has been handled.
+	 * @param pageAddress eeprom address of the page.
+	 * @param result what has happened to the page.
+	 */
+	typedef void (*PageReport)(const uint32_t pageAddress, const PAGE_RESULT result);
+
+	/**
+	 * Set the function that is called for each page. May be nullptr.
+	 */
+	void setPageReport(PageReport report) {mPageReport = report;}
+
+	/**
+	 * Set how long to wait for the next byte from the stream.
+	 * @param millis the timeout in milliseconds, 1000 by default.
+	 */
+	void setTimeout(const uint32_t millis) {mTimeoutMillis = millis;}
+
+	/**
+	 * Program a raw binary image.
+	 * @param input the stream that delivers the image.
+	 * @param address eeprom address of the first byte of the image.
+	 * @param length the number of bytes of the image.
+	 * @return IMAGE_OK, if all pages match the image, otherwise the reason
+	 * of the failure.
+	 */
+	RESULT programBinary(Stream& input, const uint32_t address, const uint32_t length);
+
+	/**
+	 * Program an Intel HEX image up to its end of file record. Data records,
+	 * extended segment and extended linear address records are supported,
+	 * start address records are ignored. Records must not carry more data
+	 * bytes than the record buffer of the template holds.
+	 * @param input the stream that delivers the image.
+	 * @return IMAGE_OK, if all pages match the image, otherwise the reason
+	 * of the failure. A record with an error is not programmed.
+	 */
+	RESULT programHex(Stream& input);
+
+	/**
+	 * get the number of pages of the last image that already matched.
+	 */
+	uint32_t pagesUnchanged() const {return mPagesUnchanged;}
+
+	/**
+	 * get the number of pages of the last image that have been written and verified.
+	 */
+	uint32_t pagesProgrammed() const {return mPagesProgrammed;}
+
+	/**
+	 * get the number of pages of the last image that could not be programmed.
+	 */
+	uint32_t pagesFailed() const {return mPagesFailed;}
+
+protected:
+	struct Page {
+		uint8_t* data;
+		uint8_t* covered;   // one bit per byte that the image provides
+		uint32_t address;
+		uint16_t first;     // span that is being written
+		uint16_t end;
+		bool valid;
+	};
+
+	AT24CxImageProgrammerBase(AT24CxEeprom& eeprom, Page* pages, uint8_t* data, uint8_t* covered,
+		const size_t pageSize, uint8_t* record, const size_t recordSize);
+
+private:
+	AT24CxEeprom& mEeprom;
+	Page* const mPages;            // two pages, the one being received and the one being written
+	const size_t mPageSize;
+	uint8_t* const mRecord;        // data bytes of an Intel HEX record
+	const size_t mRecordSize;
+	PageReport mPageReport;
+	uint32_t mTimeoutMillis;
+	Stream* mInput;
+
+	uint8_t mReceiving;            // index of the page being received
+	bool mWriting;                 // the other page is being written
+	bool mPageFailed;
+
+	uint32_t mPagesUnchanged;
+	uint32_t mPagesProgrammed;
+	uint32_t mPagesFailed;
+
+	void start(Stream& input);
+	RESULT finish(const RESULT result);
+
+	// Wait for the next byte of the stream, while the eeprom is ticked.
+	bool nextByte(uint8_t& byte);
+	RESULT nextHexByte(uint8_t& byte, uint8_t& checksum);
+
+	// Put a byte of the image into the page that is being received.
+	RESULT place(const uint32_t address, const uint8_t byte);
+
+	// Compare the received page with the eeprom and start writing it.
+	void closePage();
+
+	// Wait until the page that is being written is done, and verify it.
+	void completeWrite();
+
+	void report(const Page& page, const PAGE_RESULT result);
+};
+
+/**
+ * Image programmer for an eeprom with the given page size, e.g.
+ * AT24CxImageProgrammer<AT24C256::PAGE_SIZE>. It needs two page buffers
+ * and a buffer for the data bytes of an Intel HEX record of up to
+ * RecordSize bytes.
+ */
+template<uint16_t PageSize, uint16_t RecordSize = 32>
+class AT24CxImageProgrammer : public AT24CxImageProgrammerBase {
+public:
+	static_assert(RecordSize > 0 && RecordSize <= 255, "Intel HEX records carry 1 to 255 data bytes");
+
+	AT24CxImageProgrammer(AT24CxEeprom& eeprom)
+		: AT24CxImageProgrammerBase(eeprom, mPageStorage, mDataStorage, mCoveredStorage, PageSize,
+			mRecordStorage, RecordSize) {
+	}
+
+private:
+	Page mPageStorage[2];
+	uint8_t mDataStorage[2 * PageSize];
+	uint8_t mCoveredStorage[2 * ((PageSize + 7) / 8)];
+	uint8_t mRecordStorage[RecordSize];
+};
+
+#endif /* AT24CxImageProgrammer_HPP_ */
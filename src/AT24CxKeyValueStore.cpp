@@ -0,0 +1,421 @@
+/*
+  AT24eeprom - Arduino libary for driving the AT24 I2 based eeproms Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/AT24eeprom/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#define ASSERT assert
+
+#include "AT24CxPlatform.h"
+
+#include "AT24CxKeyValueStore.h"
+#include "AT24CxCrc.h"
+
+using AT24CxCrc::CRC16_INIT;
+using AT24CxCrc::crc16;
+
+#undef min
+static inline size_t min(size_t a, size_t b) {return a < b ? a : b;}
+
+namespace { // anonymous
+
+constexpr uint16_t BANK_MAGIC = 0x564B;
+
+// Length of an entry that marks its key as erased.
+constexpr uint16_t ERASED_LENGTH = 0xFFFF;
+
+// Size of the buffer that is used to copy entries and to read the log.
+constexpr size_t CHUNK_SIZE = 32;
+
+inline uint16_t hashKey(const uint16_t key) {
+	return static_cast<uint16_t>(key * 40503U);
+}
+
+inline bool isNewer(const uint16_t generation, const uint16_t reference) {
+	return static_cast<int16_t>(generation - reference) > 0;
+}
+
+inline void putWord(uint8_t* bytes, const uint16_t word) {
+	bytes[0] = lowByte(word);
+	bytes[1] = highByte(word);
+}
+
+inline uint16_t getWord(const uint8_t* bytes) {
+	return static_cast<uint16_t>(bytes[0] | (bytes[1] << 8));
+}
+
+} // anonymous namespace
+
+// Parses the log while it is read, and builds the index.
+class AT24CxKeyValueStoreBase::ScanSink : public AT24CxEeprom::ReadSink {
+public:
+	ScanSink(AT24CxKeyValueStoreBase& store)
+		: mStore(store), mOffset(BANK_HEADER_SIZE), mHeader(), mReceived(0), mCrc(CRC16_INIT),
+		  mDone(false), mOverflow(false) {
+	}
+
+	void receive(const uint8_t byte) override {
+		if (mDone) {
+			return;
+		}
+
+		if (mReceived < ENTRY_HEADER_SIZE) {
+			mHeader[mReceived] = byte;
+			if (mReceived < ENTRY_HEADER_SIZE - sizeof(uint16_t)) {
+				mCrc = crc16(mCrc, byte);
+			}
+		} else {
+			mCrc = crc16(mCrc, byte);
+		}
+		++mReceived;
+
+		if (mReceived == ENTRY_HEADER_SIZE) {
+			const uint16_t key = getWord(&mHeader[0]);
+			const uint16_t length = valueLength();
+			if (key == INVALID_KEY || getWord(&mHeader[4]) != mStore.mGeneration
+					|| static_cast<uint32_t>(mOffset) + ENTRY_HEADER_SIZE + length > mStore.mBankSize) {
+				// End of the log.
+				mDone = true;
+				return;
+			}
+		}
+
+		if (mReceived >= ENTRY_HEADER_SIZE && mReceived == ENTRY_HEADER_SIZE + valueLength()) {
+			completeEntry();
+		}
+	}
+
+	bool done() const {return mDone;}
+	bool overflow() const {return mOverflow;}
+	uint16_t offset() const {return mOffset;}
+
+private:
+	AT24CxKeyValueStoreBase& mStore;
+	uint16_t mOffset;
+	uint8_t mHeader[ENTRY_HEADER_SIZE];
+	uint16_t mReceived;
+	uint16_t mCrc;
+	bool mDone;
+	bool mOverflow;
+
+	uint16_t valueLength() const {
+		const uint16_t length = getWord(&mHeader[2]);
+		return length == ERASED_LENGTH ? 0 : length;
+	}
+
+	void completeEntry() {
+		if (mCrc != getWord(&mHeader[6])) {
+			// Torn entry, end of the log.
+			mDone = true;
+			return;
+		}
+
+		const uint16_t key = getWord(&mHeader[0]);
+		const uint16_t length = getWord(&mHeader[2]);
+		if (length == ERASED_LENGTH) {
+			mStore.remove(key);
+		} else if (not mStore.insert(key, mOffset, length)) {
+			mOverflow = true;
+		}
+
+		mOffset += ENTRY_HEADER_SIZE + valueLength();
+		mReceived = 0;
+		mCrc = CRC16_INIT;
+	}
+};
+
+AT24CxKeyValueStoreBase::AT24CxKeyValueStoreBase(AT24CxEeprom& eeprom, const uint32_t regionAddress,
+	const uint16_t regionSize, IndexEntry* index, const uint16_t indexCapacity)
+		: mEeprom(eeprom), mRegionAddress(regionAddress), mBankSize(regionSize / 2), mIndex(index),
+		  mIndexCapacity(indexCapacity), mSize(0), mGeneration(0), mActiveBank(0),
+		  mWriteOffset(BANK_HEADER_SIZE) {
+	ASSERT(regionAddress + regionSize <= eeprom.totalSize());
+	ASSERT(mBankSize > BANK_HEADER_SIZE + ENTRY_HEADER_SIZE);
+	clearIndex();
+}
+
+// --- Index
+
+void AT24CxKeyValueStoreBase::clearIndex() {
+	for (uint16_t i = 0; i < mIndexCapacity; i++) {
+		mIndex[i].key = INVALID_KEY;
+	}
+	mSize = 0;
+}
+
+uint16_t AT24CxKeyValueStoreBase::find(const uint16_t key) const {
+	const uint16_t mask = mIndexCapacity - 1;
+	for (uint16_t i = hashKey(key) & mask, n = 0; n < mIndexCapacity; i = (i + 1) & mask, n++) {
+		if (mIndex[i].key == key) {
+			return i;
+		}
+		if (mIndex[i].key == INVALID_KEY) {
+			break;
+		}
+	}
+	return mIndexCapacity;
+}
+
+bool AT24CxKeyValueStoreBase::insert(const uint16_t key, const uint16_t offset, const uint16_t length) {
+	const uint16_t mask = mIndexCapacity - 1;
+	uint16_t i = hashKey(key) & mask;
+	while (mIndex[i].key != INVALID_KEY && mIndex[i].key != key) {
+		i = (i + 1) & mask;
+	}
+	if (mIndex[i].key == INVALID_KEY) {
+		// Keep one slot free, so that a probe always terminates.
+		if (mSize + 1 >= mIndexCapacity) {
+			return false;
+		}
+		++mSize;
+	}
+	mIndex[i].key = key;
+	mIndex[i].offset = offset;
+	mIndex[i].length = length;
+	return true;
+}
+
+void AT24CxKeyValueStoreBase::remove(const uint16_t key) {
+	uint16_t i = find(key);
+	if (i >= mIndexCapacity) {
+		return;
+	}
+
+	// Backward shift deletion: Move up the following entries of the probe
+	// sequence, that would not be found anymore otherwise.
+	const uint16_t mask = mIndexCapacity - 1;
+	for (uint16_t j = (i + 1) & mask; mIndex[j].key != INVALID_KEY; j = (j + 1) & mask) {
+		const uint16_t home = hashKey(mIndex[j].key) & mask;
+		if (((j - home) & mask) >= ((j - i) & mask)) {
+			mIndex[i] = mIndex[j];
+			i = j;
+		}
+	}
+	mIndex[i].key = INVALID_KEY;
+	--mSize;
+}
+
+// --- Log
+
+bool AT24CxKeyValueStoreBase::readBankHeader(const uint8_t bank, uint16_t& generation) {
+	uint8_t header[BANK_HEADER_SIZE];
+	if (not mEeprom.read(bankAddress(bank), header, BANK_HEADER_SIZE)) {
+		return false;
+	}
+	generation = getWord(&header[2]);
+	return getWord(&header[0]) == BANK_MAGIC && static_cast<uint16_t>(~getWord(&header[4])) == generation;
+}
+
+bool AT24CxKeyValueStoreBase::writeBankHeader(const uint8_t bank, const uint16_t generation) {
+	uint8_t header[BANK_HEADER_SIZE];
+	putWord(&header[0], BANK_MAGIC);
+	putWord(&header[2], generation);
+	putWord(&header[4], static_cast<uint16_t>(~generation));
+	return mEeprom.write(bankAddress(bank), header, BANK_HEADER_SIZE);
+}
+
+bool AT24CxKeyValueStoreBase::scan() {
+	clearIndex();
+
+	// Read the log chunk wise, until the end of the log has been found.
+	ScanSink sink(*this);
+	uint16_t offset = BANK_HEADER_SIZE;
+	while (not sink.done() && offset < mBankSize) {
+		const uint16_t n = static_cast<uint16_t>(min(CHUNK_SIZE, mBankSize - offset));
+		if (not mEeprom.read(bankAddress(mActiveBank) + offset, sink, n)) {
+			return false;
+		}
+		offset += n;
+	}
+	mWriteOffset = sink.offset();
+	return not sink.overflow();
+}
+
+bool AT24CxKeyValueStoreBase::begin() {
+	uint16_t generation0 = 0;
+	uint16_t generation1 = 0;
+	bool valid0 = readBankHeader(0, generation0);
+	bool valid1 = readBankHeader(1, generation1);
+
+	if (valid1 && (not valid0 || isNewer(generation1, generation0))) {
+		mActiveBank = 1;
+		mGeneration = generation1;
+	} else if (valid0) {
+		mActiveBank = 0;
+		mGeneration = generation0;
+	} else {
+		// Unformatted region
+		mActiveBank = 0;
+		mGeneration = 1;
+		if (not writeBankHeader(mActiveBank, mGeneration)) {
+			return false;
+		}
+	}
+	return scan();
+}
+
+bool AT24CxKeyValueStoreBase::append(const uint16_t key, const uint8_t* value, const uint16_t length,
+		uint16_t& offset) {
+	const uint16_t valueLength = (length == ERASED_LENGTH) ? 0 : length;
+	const uint32_t entrySize = static_cast<uint32_t>(ENTRY_HEADER_SIZE) + valueLength;
+	if (mWriteOffset + entrySize > mBankSize) {
+		if (not compact() || mWriteOffset + entrySize > mBankSize) {
+			return false;
+		}
+	}
+
+	// The header and the beginning of the value are written together, so
+	// that a small entry needs only a single page write.
+	uint8_t chunk[CHUNK_SIZE];
+	putWord(&chunk[0], key);
+	putWord(&chunk[2], length);
+	putWord(&chunk[4], mGeneration);
+	const uint16_t crc = crc16(crc16(CRC16_INIT, chunk, ENTRY_HEADER_SIZE - sizeof(uint16_t)), value, valueLength);
+	putWord(&chunk[6], crc);
+
+	const size_t head = min(valueLength, CHUNK_SIZE - ENTRY_HEADER_SIZE);
+	if (head > 0) {
+		memcpy(&chunk[ENTRY_HEADER_SIZE], value, head);
+	}
+
+	const uint32_t address = bankAddress(mActiveBank) + mWriteOffset;
+	if (not mEeprom.write(address, chunk, ENTRY_HEADER_SIZE + head)) {
+		return false;
+	}
+	if (valueLength > head
+			&& not mEeprom.write(address + ENTRY_HEADER_SIZE + head, &value[head], valueLength - head)) {
+		return false;
+	}
+
+	offset = mWriteOffset;
+	mWriteOffset += entrySize;
+	return true;
+}
+
+bool AT24CxKeyValueStoreBase::compact() {
+	const uint8_t targetBank = mActiveBank ^ 1;
+	const uint16_t generation = mGeneration + 1;
+	const uint32_t source = bankAddress(mActiveBank);
+	const uint32_t target = bankAddress(targetBank);
+
+	uint16_t writeOffset = BANK_HEADER_SIZE;
+	for (uint16_t i = 0; i < mIndexCapacity; i++) {
+		IndexEntry& entry = mIndex[i];
+		if (entry.key == INVALID_KEY) {
+			continue;
+		}
+
+		// Copy the value first and calculate the crc on the way, the header
+		// is written last.
+		uint8_t chunk[CHUNK_SIZE];
+		putWord(&chunk[0], entry.key);
+		putWord(&chunk[2], entry.length);
+		putWord(&chunk[4], generation);
+		uint16_t crc = crc16(CRC16_INIT, chunk, ENTRY_HEADER_SIZE - sizeof(uint16_t));
+
+		for (uint16_t copied = 0; copied < entry.length;) {
+			const uint16_t n = static_cast<uint16_t>(min(CHUNK_SIZE, entry.length - copied));
+			const uint16_t valueOffset = ENTRY_HEADER_SIZE + copied;
+			if (not mEeprom.read(source + entry.offset + valueOffset, chunk, n)
+					|| not mEeprom.write(target + writeOffset + valueOffset, chunk, n)) {
+				begin();
+				return false;
+			}
+			crc = crc16(crc, chunk, n);
+			copied += n;
+		}
+
+		putWord(&chunk[0], entry.key);
+		putWord(&chunk[2], entry.length);
+		putWord(&chunk[4], generation);
+		putWord(&chunk[6], crc);
+		if (not mEeprom.write(target + writeOffset, chunk, ENTRY_HEADER_SIZE)) {
+			begin();
+			return false;
+		}
+
+		entry.offset = writeOffset;
+		writeOffset += ENTRY_HEADER_SIZE + entry.length;
+	}
+
+	// The target bank becomes valid with its header. Until then, the source
+	// bank remains the active one.
+	if (not writeBankHeader(targetBank, generation)) {
+		begin();
+		return false;
+	}
+
+	mActiveBank = targetBank;
+	mGeneration = generation;
+	mWriteOffset = writeOffset;
+	return true;
+}
+
+// --- Public interface
+
+bool AT24CxKeyValueStoreBase::put(const uint16_t key, const void* value, const uint16_t length) {
+	if (key == INVALID_KEY || length == ERASED_LENGTH) {
+		return false;
+	}
+	if (not contains(key) && mSize + 1 >= mIndexCapacity) {
+		return false;
+	}
+
+	uint16_t offset = 0;
+	if (not append(key, static_cast<const uint8_t*>(value), length, offset)) {
+		return false;
+	}
+	return insert(key, offset, length);
+}
+
+bool AT24CxKeyValueStoreBase::get(const uint16_t key, void* value, const uint16_t maxLength, uint16_t& length) {
+	const uint16_t i = find(key);
+	if (i >= mIndexCapacity) {
+		return false;
+	}
+
+	const IndexEntry& entry = mIndex[i];
+	length = entry.length;
+	return mEeprom.read(bankAddress(mActiveBank) + entry.offset + ENTRY_HEADER_SIZE,
+		static_cast<uint8_t*>(value), min(maxLength, entry.length));
+}
+
+bool AT24CxKeyValueStoreBase::get(const uint16_t key, void* value, const uint16_t maxLength) {
+	uint16_t length = 0;
+	return get(key, value, maxLength, length);
+}
+
+bool AT24CxKeyValueStoreBase::erase(const uint16_t key) {
+	if (not contains(key)) {
+		return false;
+	}
+
+	uint16_t offset = 0;
+	if (not append(key, nullptr, ERASED_LENGTH, offset)) {
+		return false;
+	}
+	remove(key);
+	return true;
+}
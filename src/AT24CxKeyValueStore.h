@@ -0,0 +1,189 @@
+/*
+  AT24eeprom - Arduino libary for driving the AT24 I2 based eeproms Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/AT24eeprom/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+
+#pragma once
+
+#ifndef AT24CxKeyValueStore_HPP_
+#define AT24CxKeyValueStore_HPP_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "AT24CxEeprom.h"
+
+/**
+ * Log structured key value store with 16 bit keys and variable length
+ * values, that uses an eeprom region as backing device.
+ *
+ * The region is split into two banks. Entries are appended to the active
+ * bank. When it is full, the live entries are copied to the other bank,
+ * which then becomes the active one. A RAM index maps each key to its entry,
+ * so get() needs a single eeprom read.
+ *
+ * Each entry consists of the key, the value length, the bank generation and
+ * a CRC-16 over all of them and the value. An entry that has been torn by a
+ * power loss fails the CRC check and ends the log.
+ *
+ * Use the AT24CxKeyValueStore template to get a store with its own index.
+ */
+class AT24CxKeyValueStoreBase {
+public:
+	/**
+	 * The key 0xFFFF is reserved.
+	 */
+	static constexpr uint16_t INVALID_KEY = 0xFFFF;
+
+	/**
+	 * Mount the store: Find the active bank and build the index by reading
+	 * the log once. An empty or unformatted region is formatted.
+	 * To be called before any other operation.
+	 * @return true, on success, otherwise false.
+	 */
+	bool begin();
+
+	/**
+	 * Store a value.
+	 * @param key the key of the value, any key but INVALID_KEY.
+	 * @param value the value that shall be stored.
+	 * @param length the length of the value in bytes.
+	 * @return true, on success, otherwise false. Fails if neither the region
+	 * nor the index can take the value.
+	 */
+	bool put(const uint16_t key, const void* value, const uint16_t length);
+
+	/**
+	 * Retrieve a value.
+	 * @param key the key of the value.
+	 * @param value the location where the value shall be returned.
+	 * @param maxLength the size of the location. A longer value is truncated.
+	 * @param length returns the length of the stored value.
+	 * @return true, if the key exists and the value could be read, otherwise false.
+	 */
+	bool get(const uint16_t key, void* value, const uint16_t maxLength, uint16_t& length);
+
+	/**
+	 * Retrieve a value.
+	 * @return true, if the key exists and the value could be read, otherwise false.
+	 */
+	bool get(const uint16_t key, void* value, const uint16_t maxLength);
+
+	/**
+	 * Remove a key.
+	 * @param key the key that shall be removed.
+	 * @return true, if the key has been removed, false if it doesn't exist
+	 * or on failure.
+	 */
+	bool erase(const uint16_t key);
+
+	/**
+	 * Check whether a key exists.
+	 */
+	bool contains(const uint16_t key) const {return find(key) < mIndexCapacity;}
+
+	/**
+	 * Copy the live entries to the other bank, so that the space of
+	 * overwritten and erased entries becomes available again. Called by put()
+	 * and erase() when the active bank is full.
+	 * @return true, on success, otherwise false.
+	 */
+	bool compact();
+
+	/**
+	 * get the number of keys in the store.
+	 */
+	uint16_t size() const {return mSize;}
+
+	/**
+	 * get the number of bytes left in the active bank.
+	 */
+	uint16_t freeSpace() const {return mBankSize - mWriteOffset;}
+
+protected:
+	struct IndexEntry {
+		uint16_t key;
+		uint16_t offset; // entry offset within the bank
+		uint16_t length;
+	};
+
+	AT24CxKeyValueStoreBase(AT24CxEeprom& eeprom, const uint32_t regionAddress,
+		const uint16_t regionSize, IndexEntry* index, const uint16_t indexCapacity);
+
+private:
+	static constexpr uint16_t BANK_HEADER_SIZE = 6;
+	static constexpr uint16_t ENTRY_HEADER_SIZE = 8;
+
+	class ScanSink;
+
+	AT24CxEeprom& mEeprom;
+	const uint32_t mRegionAddress;
+	const uint16_t mBankSize;
+	IndexEntry* const mIndex;
+	const uint16_t mIndexCapacity;
+	uint16_t mSize;
+	uint16_t mGeneration;
+	uint8_t mActiveBank;
+	uint16_t mWriteOffset;
+
+	inline uint32_t bankAddress(const uint8_t bank) const {
+		return mRegionAddress + static_cast<uint32_t>(bank) * mBankSize;
+	}
+
+	// Index, open addressing with linear probing.
+	uint16_t find(const uint16_t key) const;
+	bool insert(const uint16_t key, const uint16_t offset, const uint16_t length);
+	void remove(const uint16_t key);
+	void clearIndex();
+
+	bool readBankHeader(const uint8_t bank, uint16_t& generation);
+	bool writeBankHeader(const uint8_t bank, const uint16_t generation);
+	bool scan();
+	bool append(const uint16_t key, const uint8_t* value, const uint16_t length, uint16_t& offset);
+};
+
+/**
+ * Key value store with an index for up to IndexCapacity - 1 keys.
+ * IndexCapacity must be a power of 2.
+ */
+template<uint16_t IndexCapacity>
+class AT24CxKeyValueStore : public AT24CxKeyValueStoreBase {
+public:
+	static_assert(IndexCapacity >= 2 && (IndexCapacity & (IndexCapacity - 1)) == 0,
+		"IndexCapacity must be a power of 2");
+
+	/**
+	 * @param eeprom the eeprom that holds the region.
+	 * @param regionAddress eeprom address of the region.
+	 * @param regionSize the size of the region in bytes. Each of the two banks
+	 * gets one half of it.
+	 */
+	AT24CxKeyValueStore(AT24CxEeprom& eeprom, const uint32_t regionAddress, const uint16_t regionSize)
+		: AT24CxKeyValueStoreBase(eeprom, regionAddress, regionSize, mIndexStorage, IndexCapacity) {
+	}
+
+private:
+	IndexEntry mIndexStorage[IndexCapacity];
+};
+
+#endif /* AT24CxKeyValueStore_HPP_ */
@@ -0,0 +1,182 @@
+/*
+  AT24eeprom - Arduino libary for driving the AT24 I2 based eeproms Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/AT24eeprom/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+#if defined(__linux__) && !defined(ARDUINO)
+
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+
+#include "AT24CxLinuxI2cTransport.h"
+
+#undef min
+static inline size_t min(size_t a, size_t b) {return a < b ? a : b;}
+
+// Error codes of the transport interface.
+static constexpr uint8_t NO_ERROR = 0;
+static constexpr uint8_t ADDRESS_NACK = 2;
+static constexpr uint8_t DATA_NACK = 3;
+static constexpr uint8_t OTHER_ERROR = 4;
+
+AT24CxLinuxI2cTransport::AT24CxLinuxI2cTransport(const char* device)
+	: mDevice(device), mFd(-1), mErrno(0), mTxAddress(0), mTxLength(0), mRxLength(0), mRxIndex(0) {
+}
+
+AT24CxLinuxI2cTransport::~AT24CxLinuxI2cTransport() {
+	if (isOpen()) {
+		close(mFd);
+	}
+}
+
+void AT24CxLinuxI2cTransport::begin() {
+	if (not isOpen()) {
+		mFd = open(mDevice, O_RDWR);
+		mErrno = isOpen() ? 0 : errno;
+	}
+}
+
+void AT24CxLinuxI2cTransport::beginTransmission(const uint8_t deviceAddress) {
+	mTxAddress = deviceAddress;
+	mTxLength = 0;
+}
+
+size_t AT24CxLinuxI2cTransport::write(const uint8_t byte) {
+	return write(&byte, 1);
+}
+
+size_t AT24CxLinuxI2cTransport::write(const uint8_t* bytes, const size_t count) {
+	const size_t n = min(count, TX_BUFFER_SIZE - mTxLength);
+	memcpy(&mTxBuffer[mTxLength], bytes, n);
+	mTxLength += n;
+	return n;
+}
+
+uint8_t AT24CxLinuxI2cTransport::toError(const int error, const bool addressOnly) {
+	mErrno = error;
+	switch (error) {
+	case ENXIO:
+		return ADDRESS_NACK;
+	case EREMOTEIO:
+		// Some adapters report any NACK like this.
+		return addressOnly ? ADDRESS_NACK : DATA_NACK;
+	default:
+		return OTHER_ERROR;
+	}
+}
+
+uint8_t AT24CxLinuxI2cTransport::quickWrite(const uint8_t deviceAddress) {
+	if (ioctl(mFd, I2C_SLAVE, deviceAddress) < 0) {
+		return toError(errno, true);
+	}
+	i2c_smbus_ioctl_data data;
+	data.read_write = I2C_SMBUS_WRITE;
+	data.command = 0;
+	data.size = I2C_SMBUS_QUICK;
+	data.data = nullptr;
+	if (ioctl(mFd, I2C_SMBUS, &data) < 0) {
+		return toError(errno, true);
+	}
+	return NO_ERROR;
+}
+
+uint8_t AT24CxLinuxI2cTransport::endTransmission() {
+	if (not isOpen()) {
+		return OTHER_ERROR;
+	}
+	i2c_msg message;
+	message.addr = mTxAddress;
+	message.flags = 0;
+	message.len = static_cast<uint16_t>(mTxLength);
+	message.buf = mTxBuffer;
+
+	i2c_rdwr_ioctl_data transfer;
+	transfer.msgs = &message;
+	transfer.nmsgs = 1;
+	if (ioctl(mFd, I2C_RDWR, &transfer) < 0) {
+		if (mTxLength == 0 && errno == EOPNOTSUPP) {
+			return quickWrite(mTxAddress);
+		}
+		return toError(errno, mTxLength == 0);
+	}
+	return NO_ERROR;
+}
+
+size_t AT24CxLinuxI2cTransport::requestFrom(const uint8_t deviceAddress, const uint8_t* wordAddress,
+		const uint8_t wordAddressLength, const size_t count, uint8_t& error) {
+	mRxLength = 0;
+	mRxIndex = 0;
+	if (not isOpen()) {
+		error = OTHER_ERROR;
+		return 0;
+	}
+
+	// The word address, if any, and the read, joined by a repeated START.
+	i2c_msg messages[2];
+	uint8_t n = 0;
+	uint8_t word[2];
+	if (wordAddressLength > 0) {
+		memcpy(word, wordAddress, min(wordAddressLength, sizeof(word)));
+		messages[n].addr = deviceAddress;
+		messages[n].flags = 0;
+		messages[n].len = static_cast<uint16_t>(min(wordAddressLength, sizeof(word)));
+		messages[n].buf = word;
+		++n;
+	}
+	const size_t length = min(count, RX_BUFFER_SIZE);
+	messages[n].addr = deviceAddress;
+	messages[n].flags = I2C_M_RD;
+	messages[n].len = static_cast<uint16_t>(length);
+	messages[n].buf = mRxBuffer;
+	++n;
+
+	i2c_rdwr_ioctl_data transfer;
+	transfer.msgs = messages;
+	transfer.nmsgs = n;
+	if (ioctl(mFd, I2C_RDWR, &transfer) < 0) {
+		// A NACK can only occur on a device address or the word address.
+		error = toError(errno, wordAddressLength == 0);
+		return 0;
+	}
+	error = NO_ERROR;
+	mRxLength = length;
+	return length;
+}
+
+int AT24CxLinuxI2cTransport::available() {
+	return static_cast<int>(mRxLength - mRxIndex);
+}
+
+int AT24CxLinuxI2cTransport::read() {
+	if (mRxIndex >= mRxLength) {
+		return -1;
+	}
+	return mRxBuffer[mRxIndex++];
+}
+
+#endif
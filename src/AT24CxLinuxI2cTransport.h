@@ -0,0 +1,105 @@
+/*
+  AT24eeprom - Arduino libary for driving the AT24 I2 based eeproms Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/AT24eeprom/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+#pragma once
+
+#ifndef AT24CxLinuxI2cTransport_HPP_
+#define AT24CxLinuxI2cTransport_HPP_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "AT24CxTransport.h"
+
+/**
+ * Transport over a Linux i2c-dev bus, e.g. /dev/i2c-1 on a Raspberry Pi.
+ * Every transfer is a single I2C_RDWR ioctl. A read sends the word address
+ * and reads the bytes within the same ioctl, joined by a repeated START,
+ * so no other bus master can move the address counter in between.
+ *
+ * The bus clock is set by the kernel, e.g. with the device tree, so
+ * setClock() has no effect. A kernel driver that is bound to the eeprom,
+ * like at24, should be unbound first.
+ */
+class AT24CxLinuxI2cTransport : public AT24CxTransport {
+public:
+	/**
+	 * @param device the path of the bus, e.g. "/dev/i2c-1". It is opened
+	 * by begin().
+	 */
+	AT24CxLinuxI2cTransport(const char* device);
+	~AT24CxLinuxI2cTransport();
+
+	/**
+	 * Check whether begin() has opened the bus.
+	 */
+	bool isOpen() const {return mFd >= 0;}
+
+	/**
+	 * get the errno of the last failed transfer.
+	 */
+	int lastErrno() const {return mErrno;}
+
+	void begin() override;
+	void setClock(const uint32_t) override {}
+	void beginTransmission(const uint8_t deviceAddress) override;
+	size_t write(const uint8_t byte) override;
+	size_t write(const uint8_t* bytes, const size_t count) override;
+	uint8_t endTransmission() override;
+	size_t requestFrom(const uint8_t deviceAddress, const uint8_t* wordAddress,
+		const uint8_t wordAddressLength, const size_t count, uint8_t& error) override;
+	int available() override;
+	int read() override;
+	size_t maxWriteQuantity() const override {return TX_BUFFER_SIZE;}
+	size_t maxReadQuantity() const override {return RX_BUFFER_SIZE;}
+
+private:
+	// A page of 256 bytes and a word address of 2 bytes.
+	static constexpr size_t TX_BUFFER_SIZE = 258;
+	static constexpr size_t RX_BUFFER_SIZE = 256;
+
+	const char* const mDevice;
+	int mFd;
+	int mErrno;
+
+	uint8_t mTxAddress;
+	uint8_t mTxBuffer[TX_BUFFER_SIZE];
+	size_t mTxLength;
+
+	uint8_t mRxBuffer[RX_BUFFER_SIZE];
+	size_t mRxLength;
+	size_t mRxIndex;
+
+	AT24CxLinuxI2cTransport(const AT24CxLinuxI2cTransport&) = delete;
+	AT24CxLinuxI2cTransport& operator=(const AT24CxLinuxI2cTransport&) = delete;
+
+	// Probe the device address with an SMBus quick write, for adapters
+	// that don't support messages without data.
+	uint8_t quickWrite(const uint8_t deviceAddress);
+
+	// Map the errno of a failed transfer to the error codes of the transport.
+	uint8_t toError(const int error, const bool addressOnly);
+};
+
+#endif /* AT24CxLinuxI2cTransport_HPP_ */
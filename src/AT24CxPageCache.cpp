@@ -0,0 +1,209 @@
+/*
+  AT24eeprom - Arduino libary for driving the AT24 I2 based eeproms Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/AT24eeprom/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#define ASSERT assert
+
+#include "AT24CxPageCache.h"
+
+#undef min
+static inline size_t min(size_t a, size_t b) {return a < b ? a : b;}
+
+AT24CxPageCacheBase::AT24CxPageCacheBase(AT24CxEeprom& eeprom, Line* lines, uint8_t* data,
+	const size_t lineCount, const size_t lineSize)
+		: mEeprom(eeprom), mLines(lines), mData(data), mLineCount(lineCount), mUseCounter(0) {
+	ASSERT(lineSize >= eeprom.pageSize());
+	(void)lineSize;
+	invalidate();
+}
+
+void AT24CxPageCacheBase::invalidate() {
+	for (size_t i = 0; i < mLineCount; i++) {
+		Line& line = mLines[i];
+		line.valid = false;
+		line.lastUse = 0;
+		line.dirtyBegin = 0;
+		line.dirtyEnd = 0;
+	}
+}
+
+bool AT24CxPageCacheBase::isDirty() const {
+	for (size_t i = 0; i < mLineCount; i++) {
+		if (mLines[i].valid && isDirty(mLines[i])) {
+			return true;
+		}
+	}
+	return false;
+}
+
+size_t AT24CxPageCacheBase::find(const uint32_t pageAlignedAddress) const {
+	for (size_t i = 0; i < mLineCount; i++) {
+		if (mLines[i].valid && mLines[i].pageAlignedAddress == pageAlignedAddress) {
+			return i;
+		}
+	}
+	return mLineCount;
+}
+
+bool AT24CxPageCacheBase::flushLine(Line& line, const uint8_t* data) {
+	if (line.valid && isDirty(line)) {
+		// The dirty span lies within one page, so it is written with a single
+		// page write.
+		if (not mEeprom.write(line.pageAlignedAddress + line.dirtyBegin, &data[line.dirtyBegin],
+				line.dirtyEnd - line.dirtyBegin)) {
+			return false;
+		}
+		line.dirtyBegin = 0;
+		line.dirtyEnd = 0;
+	}
+	return true;
+}
+
+bool AT24CxPageCacheBase::allocate(const uint32_t pageAlignedAddress, const bool load, size_t& index) {
+	index = find(pageAlignedAddress);
+	if (index < mLineCount) {
+		mLines[index].lastUse = ++mUseCounter;
+		return true;
+	}
+
+	// Pick an unused line, or else the least recently used one.
+	index = 0;
+	for (size_t i = 0; i < mLineCount; i++) {
+		if (not mLines[i].valid) {
+			index = i;
+			break;
+		}
+		if (mLines[i].lastUse < mLines[index].lastUse) {
+			index = i;
+		}
+	}
+
+	Line& line = mLines[index];
+	uint8_t* const data = lineData(index);
+	if (not flushLine(line, data)) {
+		return false;
+	}
+
+	line.valid = false;
+	if (load && not mEeprom.read(pageAlignedAddress, data, mEeprom.pageSize())) {
+		return false;
+	}
+	line.pageAlignedAddress = pageAlignedAddress;
+	line.dirtyBegin = 0;
+	line.dirtyEnd = 0;
+	line.lastUse = ++mUseCounter;
+	line.valid = true;
+	return true;
+}
+
+bool AT24CxPageCacheBase::write(const uint32_t address, const uint8_t byte) {
+	return write(address, &byte, 1);
+}
+
+bool AT24CxPageCacheBase::write(const uint32_t address, const uint8_t* bytes, const size_t count) {
+	const uint32_t pageSize = mEeprom.pageSize();
+	uint32_t pageAlignedAddress = address & ~(pageSize - 1);
+	size_t pageOffset = address & (pageSize - 1);
+
+	size_t i = 0;
+	while ((count - i) > 0) {
+		const size_t n = min(count - i, pageSize - pageOffset);
+
+		// A page that is overwritten completely needn't be loaded.
+		size_t index = 0;
+		if (not allocate(pageAlignedAddress, n < pageSize, index)) {
+			return false;
+		}
+
+		Line& line = mLines[index];
+		memcpy(&lineData(index)[pageOffset], &bytes[i], n);
+		if (isDirty(line)) {
+			line.dirtyBegin = static_cast<uint16_t>(min(line.dirtyBegin, pageOffset));
+			line.dirtyEnd = static_cast<uint16_t>(line.dirtyEnd < pageOffset + n ? pageOffset + n : line.dirtyEnd);
+		} else {
+			line.dirtyBegin = static_cast<uint16_t>(pageOffset);
+			line.dirtyEnd = static_cast<uint16_t>(pageOffset + n);
+		}
+
+		pageAlignedAddress += pageSize;
+		pageOffset = 0;
+		i += n;
+	}
+	return true;
+}
+
+bool AT24CxPageCacheBase::read(const uint32_t address, uint8_t& byte) {
+	return read(address, &byte, 1);
+}
+
+bool AT24CxPageCacheBase::read(const uint32_t address, uint8_t* bytes, const size_t count) {
+	const uint32_t pageSize = mEeprom.pageSize();
+	uint32_t pageAlignedAddress = address & ~(pageSize - 1);
+	size_t pageOffset = address & (pageSize - 1);
+
+	size_t i = 0;
+	while ((count - i) > 0) {
+		// Pages that are not cached are read in one go.
+		size_t n = min(count - i, pageSize - pageOffset);
+		const size_t index = find(pageAlignedAddress);
+		if (index < mLineCount) {
+			memcpy(&bytes[i], &lineData(index)[pageOffset], n);
+			mLines[index].lastUse = ++mUseCounter;
+		} else {
+			while ((count - i) > n && find(pageAlignedAddress + pageSize) == mLineCount) {
+				pageAlignedAddress += pageSize;
+				n += min(count - i - n, pageSize);
+			}
+			if (not mEeprom.read(address + i, &bytes[i], n)) {
+				return false;
+			}
+		}
+
+		pageAlignedAddress += pageSize;
+		pageOffset = 0;
+		i += n;
+	}
+	return true;
+}
+
+bool AT24CxPageCacheBase::flushPage(const uint32_t address) {
+	const size_t index = find(address & ~(mEeprom.pageSize() - 1));
+	if (index < mLineCount) {
+		return flushLine(mLines[index], lineData(index));
+	}
+	return true;
+}
+
+bool AT24CxPageCacheBase::flush() {
+	bool result = true;
+	for (size_t i = 0; i < mLineCount; i++) {
+		if (not flushLine(mLines[i], lineData(i))) {
+			result = false;
+		}
+	}
+	return result;
+}
@@ -0,0 +1,163 @@
+/*
+  AT24eeprom - Arduino libary for driving the AT24 I2 based eeproms Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/AT24eeprom/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+
+#pragma once
+
+#ifndef AT24CxPageCache_HPP_
+#define AT24CxPageCache_HPP_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "AT24CxEeprom.h"
+
+/**
+ * Write back cache for AT24C eeproms. Writes are collected in page sized
+ * cache lines and are only written to the eeprom when a line is evicted or
+ * when flush() or flushPage() is called. So several small writes that hit
+ * the same page cost a single page write cycle.
+ *
+ * Reads are served from the cache if the page is cached, otherwise directly
+ * from the eeprom. Writes that bypass the cache and go directly to the
+ * eeprom are not seen by cached pages.
+ *
+ * Use the AT24CxPageCache template to get a cache with its own storage.
+ */
+class AT24CxPageCacheBase {
+public:
+	/**
+	 * Write a single byte to the cache.
+	 * @param address eeprom address where the byte shall be written to.
+	 * @param byte the byte that shall be written.
+	 * @return true, on success, otherwise false.
+	 */
+	bool write(const uint32_t address, const uint8_t byte);
+
+	/**
+	 * Write multiple bytes to the cache.
+	 * @param address eeprom address where the first byte shall be written to.
+	 * @param bytes the bytes that shall be written.
+	 * @return true, on success, otherwise false.
+	 */
+	bool write(const uint32_t address, const uint8_t* bytes, const size_t count);
+
+	/**
+	 * Read a single byte.
+	 * @param address eeprom address from where the byte shall be read.
+	 * @param byte the location where the read byte shall be returned.
+	 * @return true, on success, otherwise false.
+	 */
+	bool read(const uint32_t address, uint8_t& byte);
+
+	/**
+	 * Read multiple bytes.
+	 * @param address eeprom address from where the first byte shall be read.
+	 * @param bytes the location where the read bytes shall be returned.
+	 * @return true, on success, otherwise false.
+	 */
+	bool read(const uint32_t address, uint8_t* bytes, const size_t count);
+
+	/**
+	 * Write all modified cache lines to the eeprom.
+	 * @return true, on success, otherwise false.
+	 */
+	bool flush();
+
+	/**
+	 * Write the cache line of the page that contains the address to the
+	 * eeprom, if it has been modified.
+	 * @param address an address within the page.
+	 * @return true, on success, otherwise false.
+	 */
+	bool flushPage(const uint32_t address);
+
+	/**
+	 * Drop all cache lines without writing them to the eeprom.
+	 */
+	void invalidate();
+
+	/**
+	 * Check whether the cache holds modified data.
+	 * @return true, if at least one cache line has been modified.
+	 */
+	bool isDirty() const;
+
+	/**
+	 * get the eeprom that the cache is layered on.
+	 */
+	AT24CxEeprom& eeprom() const {return mEeprom;}
+
+protected:
+	struct Line {
+		uint32_t pageAlignedAddress;
+		uint32_t lastUse;
+		uint16_t dirtyBegin; // first modified byte within the page
+		uint16_t dirtyEnd;   // one behind the last modified byte within the page
+		bool valid;
+	};
+
+	AT24CxPageCacheBase(AT24CxEeprom& eeprom, Line* lines, uint8_t* data,
+		const size_t lineCount, const size_t lineSize);
+
+private:
+	AT24CxEeprom& mEeprom;
+	Line* const mLines;
+	uint8_t* const mData;
+	const size_t mLineCount;
+	uint32_t mUseCounter;
+
+	inline uint8_t* lineData(const size_t index) const {return &mData[index * mEeprom.pageSize()];}
+	inline bool isDirty(const Line& line) const {return line.dirtyEnd > line.dirtyBegin;}
+
+	// Find the cache line of a page, returns mLineCount if the page is not cached.
+	size_t find(const uint32_t pageAlignedAddress) const;
+
+	// Get a cache line for a page. On a miss, the least recently used line is
+	// evicted. If the page is not going to be overwritten completely, it is
+	// loaded from the eeprom.
+	bool allocate(const uint32_t pageAlignedAddress, const bool load, size_t& index);
+
+	bool flushLine(Line& line, const uint8_t* data);
+};
+
+/**
+ * Write back cache with LineCount cache lines for an eeprom with the given
+ * page size, e.g. AT24CxPageCache<4, AT24C256::PAGE_SIZE>.
+ */
+template<size_t LineCount, uint16_t PageSize>
+class AT24CxPageCache : public AT24CxPageCacheBase {
+public:
+	static_assert(LineCount > 0, "At least one cache line is required");
+
+	AT24CxPageCache(AT24CxEeprom& eeprom)
+		: AT24CxPageCacheBase(eeprom, mLineStorage, mDataStorage, LineCount, PageSize) {
+	}
+
+private:
+	Line mLineStorage[LineCount];
+	uint8_t mDataStorage[LineCount * PageSize];
+};
+
+#endif /* AT24CxPageCache_HPP_ */
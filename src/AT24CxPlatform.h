@@ -0,0 +1,81 @@
+/*
+  AT24eeprom - Arduino libary for driving the AT24 I2 based eeproms Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/AT24eeprom/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+#pragma once
+
+#ifndef AT24CxPlatform_HPP_
+#define AT24CxPlatform_HPP_
+
+/**
+ * The parts of the Arduino core that the library uses. On Arduino, this is
+ * Arduino.h. Other builds, e.g. on Linux with AT24CxLinuxI2cTransport, get
+ * equivalents based on POSIX clocks. As on Arduino, micros() and millis()
+ * wrap at 32 bit, so elapsed times can be computed by subtraction.
+ */
+
+#if defined(ARDUINO)
+
+#include <Arduino.h>
+
+#else
+
+#include <stdint.h>
+#include <time.h>
+
+inline uint32_t micros() {
+	timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return static_cast<uint32_t>(static_cast<uint64_t>(now.tv_sec) * 1000000 + now.tv_nsec / 1000);
+}
+
+inline uint32_t millis() {
+	timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return static_cast<uint32_t>(static_cast<uint64_t>(now.tv_sec) * 1000 + now.tv_nsec / 1000000);
+}
+
+inline void delayMicroseconds(const unsigned int us) {
+	timespec duration;
+	duration.tv_sec = us / 1000000;
+	duration.tv_nsec = static_cast<long>(us % 1000000) * 1000;
+	nanosleep(&duration, nullptr);
+}
+
+inline void delay(const unsigned long ms) {
+	timespec duration;
+	duration.tv_sec = ms / 1000;
+	duration.tv_nsec = static_cast<long>(ms % 1000) * 1000000;
+	nanosleep(&duration, nullptr);
+}
+
+#define lowByte(w) ((uint8_t) ((w) & 0xff))
+#define highByte(w) ((uint8_t) ((w) >> 8))
+
+#define PROGMEM
+#define pgm_read_word(addr) (*(const uint16_t*)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t*)(addr))
+
+#endif
+
+#endif /* AT24CxPlatform_HPP_ */
@@ -0,0 +1,193 @@
+/*
+  AT24eeprom - Arduino libary for driving the AT24 I2 based eeproms Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/AT24eeprom/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+
+#include <stdint.h>
+#include <assert.h>
+#define ASSERT assert
+
+#include "AT24CxReadCache.h"
+
+#undef min
+static inline size_t min(size_t a, size_t b) {return a < b ? a : b;}
+
+namespace { // anonymous
+
+// Stores the received bytes into up to two cache lines.
+class LineSink : public AT24CxEeprom::ReadSink {
+public:
+	LineSink(uint8_t* first, uint8_t* second, const size_t lineSize)
+		: mFirst(first), mSecond(second), mLineSize(lineSize), mIndex(0) {
+	}
+
+	void receive(const uint8_t byte) override {
+		if (mIndex < mLineSize) {
+			mFirst[mIndex] = byte;
+		} else {
+			mSecond[mIndex - mLineSize] = byte;
+		}
+		++mIndex;
+	}
+
+private:
+	uint8_t* const mFirst;
+	uint8_t* const mSecond;
+	const size_t mLineSize;
+	size_t mIndex;
+};
+
+} // anonymous namespace
+
+AT24CxReadCacheBase::AT24CxReadCacheBase(AT24CxEeprom& eeprom, Line* lines, uint8_t* data,
+	const size_t lineCount, const size_t lineSize)
+		: mEeprom(eeprom), mLines(lines), mData(data), mLineCount(lineCount), mLineSize(lineSize),
+		  mUseCounter(0), mHits(0), mMisses(0), mLastMiss(0), mLastMissValid(false) {
+	ASSERT(lineSize <= eeprom.totalSize());
+	ASSERT(eeprom.mReadCache == nullptr);
+	invalidate();
+	eeprom.mReadCache = this;
+}
+
+AT24CxReadCacheBase::~AT24CxReadCacheBase() {
+	mEeprom.mReadCache = nullptr;
+}
+
+void AT24CxReadCacheBase::invalidate() {
+	for (size_t i = 0; i < mLineCount; i++) {
+		mLines[i].valid = false;
+	}
+	mLastMissValid = false;
+}
+
+void AT24CxReadCacheBase::invalidate(const uint32_t address, const size_t count) {
+	const uint32_t first = address & lineMask();
+	const uint32_t last = (static_cast<uint32_t>(address) + count - 1) & lineMask();
+	for (size_t i = 0; i < mLineCount; i++) {
+		if (mLines[i].valid && mLines[i].lineAlignedAddress >= first
+				&& mLines[i].lineAlignedAddress <= last) {
+			mLines[i].valid = false;
+		}
+	}
+}
+
+size_t AT24CxReadCacheBase::find(const uint32_t lineAlignedAddress) const {
+	for (size_t i = 0; i < mLineCount; i++) {
+		if (mLines[i].valid && mLines[i].lineAlignedAddress == lineAlignedAddress) {
+			return i;
+		}
+	}
+	return mLineCount;
+}
+
+size_t AT24CxReadCacheBase::victim(const size_t except) const {
+	size_t index = mLineCount;
+	for (size_t i = 0; i < mLineCount; i++) {
+		if (i == except) {
+			continue;
+		}
+		if (not mLines[i].valid) {
+			return i;
+		}
+		if (index == mLineCount || mLines[i].lastUse < mLines[index].lastUse) {
+			index = i;
+		}
+	}
+	return index;
+}
+
+AT24CxEeprom::Status AT24CxReadCacheBase::load(const uint32_t lineAlignedAddress, size_t& index) {
+	const uint32_t addressMask = mEeprom.totalSize() - 1;
+	const uint32_t next = (lineAlignedAddress + mLineSize) & addressMask;
+	const bool sequential = mLastMissValid
+		&& lineAlignedAddress == ((mLastMiss + mLineSize) & addressMask);
+
+	index = victim(mLineCount);
+	mLines[index].valid = false;
+
+	// Prefetch the next line with the same read, the address counter of the
+	// eeprom simply keeps on incrementing.
+	size_t second = mLineCount;
+	if (sequential && mLineCount > 1 && find(next) == mLineCount) {
+		second = victim(index);
+		mLines[second].valid = false;
+	}
+
+	const size_t lines = (second < mLineCount) ? 2 : 1;
+	LineSink sink(lineData(index), (second < mLineCount) ? lineData(second) : nullptr, mLineSize);
+	const AT24CxEeprom::Status status = mEeprom.readDirect(lineAlignedAddress, sink, lines * mLineSize);
+	if (not status) {
+		mLastMissValid = false;
+		return status;
+	}
+
+	mLines[index].lineAlignedAddress = lineAlignedAddress;
+	mLines[index].lastUse = ++mUseCounter;
+	mLines[index].valid = true;
+	mLastMiss = lineAlignedAddress;
+	mLastMissValid = true;
+	if (second < mLineCount) {
+		mLines[second].lineAlignedAddress = next;
+		mLines[second].lastUse = mUseCounter;
+		mLines[second].valid = true;
+		// A miss on the line after the prefetched one continues the sequence.
+		mLastMiss = next;
+	}
+	return status;
+}
+
+AT24CxEeprom::Status AT24CxReadCacheBase::read(const uint32_t address, AT24CxEeprom::ReadSink& sink,
+		const size_t count) {
+	const uint32_t addressMask = mEeprom.totalSize() - 1;
+	uint32_t a = address;
+	size_t i = 0;
+	bool hit = true;
+	while (i < count) {
+		const uint32_t lineAlignedAddress = a & lineMask();
+		size_t index = find(lineAlignedAddress);
+		if (index < mLineCount) {
+			mLines[index].lastUse = ++mUseCounter;
+		} else {
+			hit = false;
+			const AT24CxEeprom::Status status = load(lineAlignedAddress, index);
+			if (not status) {
+				return status;
+			}
+		}
+
+		const size_t offset = a - lineAlignedAddress;
+		const size_t n = min(count - i, mLineSize - offset);
+		const uint8_t* const data = lineData(index);
+		for (size_t j = 0; j < n; j++) {
+			sink.receive(data[offset + j]);
+		}
+		a = (a + n) & addressMask;
+		i += n;
+	}
+	if (hit) {
+		++mHits;
+	} else {
+		++mMisses;
+	}
+	return AT24CxEeprom::Status::OK;
+}
@@ -0,0 +1,135 @@
+/*
+  AT24eeprom - Arduino libary for driving the AT24 I2 based eeproms Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/AT24eeprom/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+
+#pragma once
+
+#ifndef AT24CxReadCache_HPP_
+#define AT24CxReadCache_HPP_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "AT24CxEeprom.h"
+
+/**
+ * Read cache for AT24C eeproms. Once constructed, it is attached to the
+ * eeprom and serves all reads of the eeprom that are not larger than a
+ * cache line. A missing line is loaded with a single bulk read. If the
+ * misses are sequential, the following line is loaded with the same read,
+ * so a table walk needs one address phase for every other line.
+ *
+ * All writes of the eeprom invalidate the cache lines that they hit, so the
+ * cache never returns stale data.
+ *
+ * Use the AT24CxReadCache template to get a cache with its own storage.
+ */
+class AT24CxReadCacheBase {
+public:
+	/**
+	 * Drop all cache lines.
+	 */
+	void invalidate();
+
+	/**
+	 * get the number of reads that have been served from the cache.
+	 */
+	uint32_t hits() const {return mHits;}
+
+	/**
+	 * get the number of reads that needed to load a cache line.
+	 */
+	uint32_t misses() const {return mMisses;}
+
+	/**
+	 * get the eeprom that the cache is attached to.
+	 */
+	AT24CxEeprom& eeprom() const {return mEeprom;}
+
+protected:
+	struct Line {
+		uint32_t lineAlignedAddress;
+		uint32_t lastUse;
+		bool valid;
+	};
+
+	AT24CxReadCacheBase(AT24CxEeprom& eeprom, Line* lines, uint8_t* data,
+		const size_t lineCount, const size_t lineSize);
+	~AT24CxReadCacheBase();
+
+private:
+	friend class AT24CxEeprom;
+
+	AT24CxEeprom& mEeprom;
+	Line* const mLines;
+	uint8_t* const mData;
+	const size_t mLineCount;
+	const size_t mLineSize;
+	uint32_t mUseCounter;
+	uint32_t mHits;
+	uint32_t mMisses;
+
+	// Line address of the last miss, used to detect sequential access.
+	uint32_t mLastMiss;
+	bool mLastMissValid;
+
+	inline uint8_t* lineData(const size_t index) const {return &mData[index * mLineSize];}
+	inline uint32_t lineMask() const {return ~static_cast<uint32_t>(mLineSize - 1);}
+
+	// Called by the eeprom for reads that are not larger than a line.
+	AT24CxEeprom::Status read(const uint32_t address, AT24CxEeprom::ReadSink& sink, const size_t count);
+
+	// Called by the eeprom for every write transfer.
+	void invalidate(const uint32_t address, const size_t count);
+
+	size_t find(const uint32_t lineAlignedAddress) const;
+
+	// Pick an unused line, or else the least recently used one, other than except.
+	size_t victim(const size_t except) const;
+
+	// Load the line and, on sequential access, the next line as well.
+	AT24CxEeprom::Status load(const uint32_t lineAlignedAddress, size_t& index);
+};
+
+/**
+ * Read cache with LineCount cache lines of LineSize bytes, e.g.
+ * AT24CxReadCache<4, 32>. The line size should match the receive buffer of
+ * the I2C driver, which is 32 bytes on AVR.
+ */
+template<size_t LineCount, size_t LineSize>
+class AT24CxReadCache : public AT24CxReadCacheBase {
+public:
+	static_assert(LineCount > 0, "At least one cache line is required");
+	static_assert((LineSize & (LineSize - 1)) == 0, "LineSize must be a power of 2");
+
+	AT24CxReadCache(AT24CxEeprom& eeprom)
+		: AT24CxReadCacheBase(eeprom, mLineStorage, mDataStorage, LineCount, LineSize) {
+	}
+
+private:
+	Line mLineStorage[LineCount];
+	uint8_t mDataStorage[LineCount * LineSize];
+};
+
+#endif /* AT24CxReadCache_HPP_ */
@@ -0,0 +1,102 @@
+/*
+  AT24eeprom - Arduino libary for driving the AT24 I2 based eeproms Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/AT24eeprom/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+
+#include "AT24CxStats.h"
+
+namespace { // anonymous
+
+const char* const OPERATION_NAMES[AT24CxStats::OP_COUNT] = {
+	"read", "write", "write cycle",
+};
+
+size_t printCounter(Print& p, const char* const name, const uint32_t value) {
+	size_t n = p.print(name);
+	n += p.print(": ");
+	n += p.println(value);
+	return n;
+}
+
+} // anonymous namespace
+
+void AT24CxStats::Histogram::record(const uint32_t micros) {
+	uint8_t bucket = 0;
+	for (uint32_t v = micros >> 1; v > 0 && bucket < BUCKETS - 1; v >>= 1) {
+		++bucket;
+	}
+	if (buckets[bucket] < 0xFFFF) {
+		++buckets[bucket];
+	}
+}
+
+void AT24CxStats::reset() {
+	transactions = 0;
+	payloadBytes = 0;
+	overheadBytes = 0;
+	retries = 0;
+	ackPolls = 0;
+	busyWaitMicros = 0;
+	addressNacks = 0;
+	dataNacks = 0;
+	otherErrors = 0;
+	noDataAvailable = 0;
+	timeouts = 0;
+	for (uint8_t op = 0; op < OP_COUNT; op++) {
+		for (uint8_t i = 0; i < Histogram::BUCKETS; i++) {
+			latency[op].buckets[i] = 0;
+		}
+	}
+}
+
+size_t AT24CxStats::printTo(Print& p) const {
+	size_t n = 0;
+	n += printCounter(p, "transactions", transactions);
+	n += printCounter(p, "payload bytes", payloadBytes);
+	n += printCounter(p, "overhead bytes", overheadBytes);
+	n += printCounter(p, "retries", retries);
+	n += printCounter(p, "ack polls", ackPolls);
+	n += printCounter(p, "busy wait us", busyWaitMicros);
+	n += printCounter(p, "address NACKs", addressNacks);
+	n += printCounter(p, "data NACKs", dataNacks);
+	n += printCounter(p, "other errors", otherErrors);
+	n += printCounter(p, "no data available", noDataAvailable);
+	n += printCounter(p, "timeouts", timeouts);
+
+	// Only the buckets that have counts, as "from us: count".
+	for (uint8_t op = 0; op < OP_COUNT; op++) {
+		n += p.print(OPERATION_NAMES[op]);
+		n += p.print(" latency:");
+		for (uint8_t i = 0; i < Histogram::BUCKETS; i++) {
+			const uint16_t count = latency[op].buckets[i];
+			if (count) {
+				n += p.print(' ');
+				n += p.print(i == 0 ? 0UL : 1UL << i);
+				n += p.print("us: ");
+				n += p.print(count);
+			}
+		}
+		n += p.println();
+	}
+	return n;
+}
@@ -0,0 +1,82 @@
+/*
+  AT24eeprom - Arduino libary for driving the AT24 I2 based eeproms Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/AT24eeprom/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+
+#pragma once
+
+#ifndef AT24CxStats_HPP_
+#define AT24CxStats_HPP_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <Arduino.h>
+
+/**
+ * Bus statistics of an AT24CxEeprom. Only collected if the library is
+ * compiled with AT24CxEepromEnableStats set to true.
+ */
+struct AT24CxStats : public Printable {
+	enum OPERATION : uint8_t {
+		OP_READ = 0,     // read() calls
+		OP_WRITE,        // write() calls, including their write cycles
+		OP_WRITE_CYCLE,  // internal write cycles of the eeprom, measured by acknowledge polling
+		OP_COUNT
+	};
+
+	/**
+	 * Latency histogram with logarithmic buckets: Bucket i counts latencies
+	 * from 2^i up to 2^(i+1) - 1 microseconds, the last bucket counts all
+	 * longer latencies. The counts saturate.
+	 */
+	struct Histogram {
+		static constexpr uint8_t BUCKETS = 18; // last bucket starts at 131ms
+		uint16_t buckets[BUCKETS];
+		void record(const uint32_t micros);
+	};
+
+	uint32_t transactions;        // I2C transfers, each starting with a START condition
+	uint32_t payloadBytes;        // data bytes written to or read from the eeprom
+	uint32_t overheadBytes;       // device address and word address bytes
+	uint32_t retries;             // transfers that have been repeated
+	uint32_t ackPolls;            // address only probes while waiting for a write cycle
+	uint32_t busyWaitMicros;      // time spent waiting for write cycles
+
+	// Failed transfers by error code.
+	uint32_t addressNacks;        // device address not acknowledged, e.g. busy
+	uint32_t dataNacks;           // data byte not acknowledged
+	uint32_t otherErrors;         // any other error reported by the I2C driver
+	uint32_t noDataAvailable;     // read request answered without data
+	uint32_t timeouts;            // operations aborted by the deadline of the retry policy
+
+	Histogram latency[OP_COUNT];
+
+	void reset();
+
+	/**
+	 * Print the statistics in human readable form.
+	 */
+	size_t printTo(Print& p) const override;
+};
+
+#endif /* AT24CxStats_HPP_ */
@@ -0,0 +1,156 @@
+/*
+  AT24eeprom - Arduino libary for driving the AT24 I2 based eeproms Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/AT24eeprom/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#define ASSERT assert
+
+#include "AT24CxStream.h"
+
+#undef min
+static inline size_t min(size_t a, size_t b) {return a < b ? a : b;}
+
+AT24CxStreamBase::AT24CxStreamBase(AT24CxEeprom& eeprom, const uint32_t windowAddress,
+	const uint32_t windowSize, uint8_t* buffer, const size_t bufferSize)
+		: mEeprom(eeprom), mBuffer(buffer), mBufferSize(bufferSize), mWindowAddress(windowAddress),
+		  mWindowSize(windowSize), mPosition(0), mBufferAddress(0), mBufferLength(0), mWriting(false) {
+	ASSERT(bufferSize == eeprom.pageSize());
+	ASSERT(static_cast<uint32_t>(windowAddress) + windowSize <= eeprom.totalSize());
+}
+
+bool AT24CxStreamBase::commit() {
+	if (not mWriting) {
+		return true;
+	}
+	if (not mEeprom.write(mBufferAddress, mBuffer, mBufferLength)) {
+		// Keep the bytes, so that flush() can try again.
+		setWriteError();
+		return false;
+	}
+	mWriting = false;
+	mBufferLength = 0;
+	return true;
+}
+
+bool AT24CxStreamBase::fill() {
+	const uint32_t address = mWindowAddress + mPosition;
+	if (not mWriting && address >= mBufferAddress && address < mBufferAddress + mBufferLength) {
+		return true;
+	}
+	if (not commit()) {
+		return false;
+	}
+	const size_t count = min(mBufferSize, mWindowSize - mPosition);
+	if (not mEeprom.read(address, mBuffer, count)) {
+		mBufferLength = 0;
+		return false;
+	}
+	mBufferAddress = address;
+	mBufferLength = count;
+	return true;
+}
+
+size_t AT24CxStreamBase::write(uint8_t byte) {
+	return write(&byte, 1);
+}
+
+size_t AT24CxStreamBase::write(const uint8_t *buffer, size_t size) {
+	size_t written = 0;
+	while (written < size && mPosition < mWindowSize) {
+		const uint32_t address = mWindowAddress + mPosition;
+
+		// Start a new run, unless the bytes continue the buffered ones.
+		if (not mWriting || mBufferAddress + mBufferLength != address) {
+			if (not commit()) {
+				break;
+			}
+			mWriting = true;
+			mBufferAddress = address;
+			mBufferLength = 0;
+		}
+
+		const size_t pageRemaining = mEeprom.pageSize() - (address % mEeprom.pageSize());
+		const size_t n = min(min(size - written, pageRemaining), mWindowSize - mPosition);
+		memcpy(&mBuffer[mBufferLength], &buffer[written], n);
+		mBufferLength += n;
+		mPosition += n;
+		written += n;
+
+		// Write complete pages right away.
+		if ((n == pageRemaining || mPosition == mWindowSize) && not commit()) {
+			// The bytes of this call that are in the buffer are not written,
+			// the position returns to the first of them. Bytes of earlier
+			// calls stay buffered for flush().
+			const size_t unwritten = min(written, mBufferLength);
+			mBufferLength -= unwritten;
+			mWriting = (mBufferLength > 0);
+			mPosition -= unwritten;
+			return written - unwritten;
+		}
+	}
+	if (written < size) {
+		setWriteError();
+	}
+	return written;
+}
+
+int AT24CxStreamBase::available() {
+	return static_cast<int>(min(mWindowSize - mPosition, 0x7FFF));
+}
+
+int AT24CxStreamBase::availableForWrite() {
+	return available();
+}
+
+int AT24CxStreamBase::peek() {
+	if (mPosition >= mWindowSize || not fill()) {
+		return -1;
+	}
+	return mBuffer[mWindowAddress + mPosition - mBufferAddress];
+}
+
+int AT24CxStreamBase::read() {
+	const int byte = peek();
+	if (byte >= 0) {
+		++mPosition;
+	}
+	return byte;
+}
+
+void AT24CxStreamBase::flush() {
+	commit();
+}
+
+bool AT24CxStreamBase::seek(const uint32_t position) {
+	if (position > mWindowSize) {
+		return false;
+	}
+	if (not commit()) {
+		return false;
+	}
+	mPosition = position;
+	return true;
+}
@@ -0,0 +1,163 @@
+/*
+  AT24eeprom - Arduino libary for driving the AT24 I2 based eeproms Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/AT24eeprom/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+
+#pragma once
+
+#ifndef AT24CxStream_HPP_
+#define AT24CxStream_HPP_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include <Arduino.h>
+
+#include "AT24CxEeprom.h"
+
+/**
+ * Arduino Stream over a window of an eeprom, so that data can be printed
+ * to and parsed from the eeprom directly, without serializing it into a
+ * RAM buffer first.
+ *
+ * The stream keeps a single buffer of one page. Written bytes are collected
+ * in it and written with one page write as soon as the page is full. Reads
+ * refill the buffer with one bulk read. Reads and writes share the same
+ * position, which starts at the beginning of the window and can be changed
+ * with seek().
+ *
+ * Call flush() after the last write, to write the partially filled page.
+ * Write errors are reported by getWriteError(). Bytes that have been
+ * accepted but could not be written stay buffered, and flush() tries again.
+ *
+ * Use the AT24CxStream template to get a stream with its own buffer.
+ */
+class AT24CxStreamBase : public Stream {
+public:
+	/**
+	 * Write a single byte at the current position.
+	 * @return 1, on success, 0 at the end of the window or on a write error.
+	 */
+	size_t write(uint8_t byte) override;
+
+	/**
+	 * Write multiple bytes at the current position. If a page write fails,
+	 * the position stays behind the last byte that has been written or is
+	 * still buffered from earlier calls.
+	 * @return the number of bytes that have been written.
+	 */
+	size_t write(const uint8_t* buffer, size_t size) override;
+	using Print::write;
+
+	/**
+	 * get the number of bytes that can be read up to the end of the window.
+	 */
+	int available() override;
+
+	/**
+	 * Read the byte at the current position and advance the position.
+	 * @return the byte, or -1 at the end of the window or on a read error.
+	 */
+	int read() override;
+
+	/**
+	 * Read the byte at the current position without advancing the position.
+	 * @return the byte, or -1 at the end of the window or on a read error.
+	 */
+	int peek() override;
+
+	/**
+	 * get the number of bytes that can be written up to the end of the window.
+	 */
+	int availableForWrite() override;
+
+	/**
+	 * Write the buffered bytes to the eeprom. On failure, they stay buffered.
+	 */
+	void flush() override;
+
+	/**
+	 * Move the position. Buffered bytes are written first.
+	 * @param position the new position, relative to the start of the window.
+	 * @return true, on success, false if the position is outside of the window
+	 * or the buffered bytes could not be written.
+	 */
+	bool seek(const uint32_t position);
+
+	/**
+	 * get the current position, relative to the start of the window.
+	 */
+	uint32_t position() const {return mPosition;}
+
+	/**
+	 * get the size of the window.
+	 */
+	uint32_t size() const {return mWindowSize;}
+
+protected:
+	AT24CxStreamBase(AT24CxEeprom& eeprom, const uint32_t windowAddress, const uint32_t windowSize,
+		uint8_t* buffer, const size_t bufferSize);
+
+private:
+	AT24CxEeprom& mEeprom;
+	uint8_t* const mBuffer;
+	const size_t mBufferSize;
+	const uint32_t mWindowAddress;
+	const uint32_t mWindowSize;
+	uint32_t mPosition;
+
+	// The buffer holds mBufferLength bytes of the eeprom, starting at
+	// mBufferAddress. If mWriting is set, they have not been written yet
+	// and end at the current position.
+	uint32_t mBufferAddress;
+	size_t mBufferLength;
+	bool mWriting;
+
+	// Write the buffered bytes to the eeprom.
+	bool commit();
+
+	// Make sure that the buffer holds the byte at the current position.
+	bool fill();
+};
+
+/**
+ * Stream over a window of an eeprom with the given page size, e.g.
+ * AT24CxStream<AT24C256::PAGE_SIZE> stream(eeprom, 0x1000, 0x800);
+ */
+template<uint16_t PageSize>
+class AT24CxStream : public AT24CxStreamBase {
+public:
+	/**
+	 * @param eeprom the eeprom.
+	 * @param windowAddress eeprom address of the first byte of the window.
+	 * @param windowSize the size of the window in bytes.
+	 */
+	AT24CxStream(AT24CxEeprom& eeprom, const uint32_t windowAddress, const uint32_t windowSize)
+		: AT24CxStreamBase(eeprom, windowAddress, windowSize, mBufferStorage, PageSize) {
+	}
+
+private:
+	uint8_t mBufferStorage[PageSize];
+};
+
+#endif /* AT24CxStream_HPP_ */
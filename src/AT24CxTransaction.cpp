@@ -0,0 +1,245 @@
+/*
+  AT24eeprom - Arduino libary for driving the AT24 I2 based eeproms Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/AT24eeprom/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#define ASSERT assert
+
+#include "AT24CxPlatform.h"
+
+#include "AT24CxTransaction.h"
+#include "AT24CxCrc.h"
+
+using AT24CxCrc::CRC16_INIT;
+using AT24CxCrc::crc16;
+
+#undef min
+static inline size_t min(size_t a, size_t b) {return a < b ? a : b;}
+
+namespace { // anonymous
+
+// Layout of the commit record:
+//   magic (2 bytes), sequence (2 bytes), page count (1 byte),
+//   home page number, i.e. address / page size, for each shadow page (2 bytes each),
+//   crc over all of the above (2 bytes), state (1 byte)
+constexpr uint16_t RECORD_MAGIC = 0x5441;
+constexpr uint8_t RECORD_HEADER_SIZE = 5;
+
+// The state is written separately after the transaction has been applied.
+constexpr uint8_t STATE_COMMITTED = 0x00;
+constexpr uint8_t STATE_APPLIED = 0xA5;
+
+inline void putWord(uint8_t* bytes, const uint16_t word) {
+	bytes[0] = lowByte(word);
+	bytes[1] = highByte(word);
+}
+
+inline uint16_t getWord(const uint8_t* bytes) {
+	return static_cast<uint16_t>(bytes[0] | (bytes[1] << 8));
+}
+
+} // anonymous namespace
+
+AT24CxTransactionBase::AT24CxTransactionBase(AT24CxEeprom& eeprom, const uint32_t journalAddress,
+	uint16_t* homePages, const uint8_t maxPages, uint8_t* pageBuffer, const uint16_t pageBufferSize)
+		: mEeprom(eeprom), mJournalAddress(journalAddress), mHomePages(homePages), mMaxPages(maxPages),
+		  mPageBuffer(pageBuffer), mPageCount(0), mSequence(0), mInTransaction(false) {
+	ASSERT(pageBufferSize >= eeprom.pageSize());
+	ASSERT((journalAddress & (eeprom.pageSize() - 1)) == 0);
+	ASSERT(journalAddress + (maxPages + 1) * eeprom.pageSize() <= eeprom.totalSize());
+	(void)pageBufferSize;
+}
+
+uint8_t AT24CxTransactionBase::find(const uint32_t pageAlignedAddress) const {
+	for (uint8_t i = 0; i < mPageCount; i++) {
+		if (mHomePages[i] == pageNumber(pageAlignedAddress)) {
+			return i;
+		}
+	}
+	return mPageCount;
+}
+
+bool AT24CxTransactionBase::copyPage(const uint32_t from, const uint32_t to) {
+	const uint16_t pageSize = static_cast<uint16_t>(mEeprom.pageSize());
+	return mEeprom.read(from, mPageBuffer, pageSize) && mEeprom.write(to, mPageBuffer, pageSize);
+}
+
+bool AT24CxTransactionBase::isApplied(const uint8_t* record) const {
+	return record[recordSize() - 1] == STATE_APPLIED;
+}
+
+bool AT24CxTransactionBase::apply(const uint8_t* record) {
+	// The record lives in the page buffer, which is needed for copying.
+	mPageCount = record[4];
+	for (uint8_t i = 0; i < mPageCount; i++) {
+		mHomePages[i] = getWord(&record[RECORD_HEADER_SIZE + 2 * i]);
+	}
+
+	for (uint8_t i = 0; i < mPageCount; i++) {
+		if (not copyPage(shadowAddress(i), homeAddress(mHomePages[i]))) {
+			return false;
+		}
+	}
+	mPageCount = 0;
+	return mEeprom.write(mJournalAddress + recordSize() - 1, STATE_APPLIED);
+}
+
+bool AT24CxTransactionBase::begin() {
+	mInTransaction = false;
+	mPageCount = 0;
+
+	uint8_t* const record = mPageBuffer;
+	if (not mEeprom.read(mJournalAddress, record, recordSize())) {
+		return false;
+	}
+
+	const uint16_t crcOffset = RECORD_HEADER_SIZE + 2 * mMaxPages;
+	if (getWord(&record[0]) != RECORD_MAGIC || record[4] > mMaxPages
+			|| crc16(CRC16_INIT, record, crcOffset) != getWord(&record[crcOffset])) {
+		// No transaction has been committed yet, or the commit record is
+		// torn. In the latter case, the home pages haven't been touched.
+		return true;
+	}
+
+	mSequence = getWord(&record[2]);
+	if (isApplied(record)) {
+		return true;
+	}
+	return apply(record);
+}
+
+bool AT24CxTransactionBase::beginTransaction() {
+	if (mInTransaction) {
+		return false;
+	}
+	mPageCount = 0;
+	mInTransaction = true;
+	return true;
+}
+
+void AT24CxTransactionBase::abort() {
+	mPageCount = 0;
+	mInTransaction = false;
+}
+
+bool AT24CxTransactionBase::write(const uint32_t address, const uint8_t* bytes, const size_t count) {
+	if (not mInTransaction) {
+		return false;
+	}
+
+	const uint32_t pageSize = mEeprom.pageSize();
+	uint32_t pageAlignedAddress = address & ~(pageSize - 1);
+	size_t pageOffset = address & (pageSize - 1);
+
+	size_t i = 0;
+	while ((count - i) > 0) {
+		ASSERT(pageAlignedAddress + pageSize <= mJournalAddress
+			|| pageAlignedAddress >= mJournalAddress + (mMaxPages + 1) * pageSize);
+
+		const size_t n = min(count - i, pageSize - pageOffset);
+		uint8_t slot = find(pageAlignedAddress);
+		if (slot < mPageCount) {
+			// The page is already shadowed.
+			if (not mEeprom.write(shadowAddress(slot) + pageOffset, &bytes[i], n)) {
+				return false;
+			}
+		} else {
+			if (mPageCount >= mMaxPages) {
+				return false;
+			}
+			slot = mPageCount;
+
+			// Shadow the page: Merge the new bytes into the current page
+			// content and write it to the shadow page in one go.
+			if (n < pageSize && not mEeprom.read(pageAlignedAddress, mPageBuffer, pageSize)) {
+				return false;
+			}
+			memcpy(&mPageBuffer[pageOffset], &bytes[i], n);
+			if (not mEeprom.write(shadowAddress(slot), mPageBuffer, pageSize)) {
+				return false;
+			}
+			mHomePages[slot] = pageNumber(pageAlignedAddress);
+			++mPageCount;
+		}
+
+		pageAlignedAddress += pageSize;
+		pageOffset = 0;
+		i += n;
+	}
+	return true;
+}
+
+bool AT24CxTransactionBase::read(const uint32_t address, uint8_t* bytes, const size_t count) {
+	const uint32_t pageSize = mEeprom.pageSize();
+	uint32_t pageAlignedAddress = address & ~(pageSize - 1);
+	size_t pageOffset = address & (pageSize - 1);
+
+	size_t i = 0;
+	while ((count - i) > 0) {
+		const size_t n = min(count - i, pageSize - pageOffset);
+		const uint8_t slot = mInTransaction ? find(pageAlignedAddress) : mPageCount;
+		const uint32_t source = (slot < mPageCount) ? shadowAddress(slot) : pageAlignedAddress;
+		if (not mEeprom.read(source + pageOffset, &bytes[i], n)) {
+			return false;
+		}
+
+		pageAlignedAddress += pageSize;
+		pageOffset = 0;
+		i += n;
+	}
+	return true;
+}
+
+bool AT24CxTransactionBase::commit() {
+	if (not mInTransaction) {
+		return false;
+	}
+	mInTransaction = false;
+	if (mPageCount == 0) {
+		return true;
+	}
+
+	// Once the commit record has been written completely, the transaction
+	// is durable.
+	uint8_t* const record = mPageBuffer;
+	const uint16_t crcOffset = RECORD_HEADER_SIZE + 2 * mMaxPages;
+	putWord(&record[0], RECORD_MAGIC);
+	putWord(&record[2], mSequence + 1);
+	record[4] = mPageCount;
+	for (uint8_t i = 0; i < mMaxPages; i++) {
+		putWord(&record[RECORD_HEADER_SIZE + 2 * i], (i < mPageCount) ? mHomePages[i] : 0xFFFF);
+	}
+	putWord(&record[crcOffset], crc16(CRC16_INIT, record, crcOffset));
+	record[crcOffset + 2] = STATE_COMMITTED;
+
+	if (not mEeprom.write(mJournalAddress, record, recordSize())) {
+		// Whether the transaction is durable is unknown. begin() will find out.
+		mPageCount = 0;
+		return false;
+	}
+	++mSequence;
+	return apply(record);
+}
@@ -0,0 +1,167 @@
+/*
+  AT24eeprom - Arduino libary for driving the AT24 I2 based eeproms Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/AT24eeprom/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+
+#pragma once
+
+#ifndef AT24CxTransaction_HPP_
+#define AT24CxTransaction_HPP_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "AT24CxEeprom.h"
+
+/**
+ * Power fail safe transactions that update several eeprom pages atomically.
+ *
+ * The writes of a transaction are staged in shadow pages of a journal. Only
+ * the pages that are touched by the transaction are shadowed. commit() then
+ * writes a CRC protected commit record that lists the shadowed pages, copies
+ * the shadow pages to their home pages and finally marks the record as
+ * applied. If power is lost before the commit record is complete, none of
+ * the writes take effect. If it is lost afterwards, begin() completes the
+ * copying after the next start up.
+ *
+ * The journal consists of one page for the commit record followed by one
+ * shadow page per page that a transaction may touch. It must be page aligned
+ * and must not be written to by anybody else.
+ *
+ * Use the AT24CxTransaction template to get a transaction with its own
+ * storage.
+ */
+class AT24CxTransactionBase {
+public:
+	/**
+	 * Recover from a power loss: Complete the last committed transaction if
+	 * it hasn't been applied completely. Reads the commit record once.
+	 * To be called before the first transaction.
+	 * @return true, on success, otherwise false.
+	 */
+	bool begin();
+
+	/**
+	 * Start a transaction.
+	 * @return true, on success, false if a transaction is already in progress.
+	 */
+	bool beginTransaction();
+
+	/**
+	 * Stage multiple bytes for writing with the current transaction.
+	 * @param address eeprom address where the first byte shall be written to.
+	 * @param bytes the bytes that shall be written.
+	 * @return true, on success, otherwise false, e.g. if the transaction would
+	 * touch more pages than the journal can shadow.
+	 */
+	bool write(const uint32_t address, const uint8_t* bytes, const size_t count);
+
+	/**
+	 * Read multiple bytes as they would be after the current transaction has
+	 * been committed.
+	 * @param address eeprom address from where the first byte shall be read.
+	 * @param bytes the location where the read bytes shall be returned.
+	 * @return true, on success, otherwise false.
+	 */
+	bool read(const uint32_t address, uint8_t* bytes, const size_t count);
+
+	/**
+	 * Apply all staged writes of the current transaction atomically.
+	 * @return true, on success, otherwise false.
+	 */
+	bool commit();
+
+	/**
+	 * Discard all staged writes of the current transaction.
+	 */
+	void abort();
+
+	/**
+	 * Check whether a transaction is in progress.
+	 */
+	bool inTransaction() const {return mInTransaction;}
+
+	/**
+	 * get the sequence number of the last committed transaction.
+	 */
+	uint16_t sequence() const {return mSequence;}
+
+protected:
+	AT24CxTransactionBase(AT24CxEeprom& eeprom, const uint32_t journalAddress, uint16_t* homePages,
+		const uint8_t maxPages, uint8_t* pageBuffer, const uint16_t pageBufferSize);
+
+private:
+	AT24CxEeprom& mEeprom;
+	const uint32_t mJournalAddress;
+	uint16_t* const mHomePages; // home page number, i.e. address / page size, of each shadow page
+	const uint8_t mMaxPages;
+	uint8_t* const mPageBuffer;
+	uint8_t mPageCount;
+	uint16_t mSequence;
+	bool mInTransaction;
+
+	inline uint32_t shadowAddress(const uint8_t slot) const {
+		return mJournalAddress + (slot + 1) * mEeprom.pageSize();
+	}
+	inline uint16_t pageNumber(const uint32_t pageAlignedAddress) const {
+		return static_cast<uint16_t>(pageAlignedAddress / mEeprom.pageSize());
+	}
+	inline uint32_t homeAddress(const uint16_t pageNumber) const {
+		return static_cast<uint32_t>(pageNumber) * mEeprom.pageSize();
+	}
+	inline uint16_t recordSize() const {return 5 + 2 * mMaxPages + 3;}
+
+	// Find the shadow page of a home page, returns mPageCount if the page is not shadowed.
+	uint8_t find(const uint32_t pageAlignedAddress) const;
+
+	bool copyPage(const uint32_t from, const uint32_t to);
+	bool apply(const uint8_t* record);
+	bool isApplied(const uint8_t* record) const;
+};
+
+/**
+ * Transaction that may touch up to MaxPages pages of an eeprom with the given
+ * page size, e.g. AT24CxTransaction<4, AT24C256::PAGE_SIZE>. The journal takes
+ * MaxPages + 1 pages.
+ */
+template<uint8_t MaxPages, uint16_t PageSize>
+class AT24CxTransaction : public AT24CxTransactionBase {
+public:
+	static_assert(MaxPages > 0, "At least one page is required");
+	static_assert(5 + 2 * MaxPages + 3 <= PageSize, "The commit record must fit into a page");
+
+	/**
+	 * @param eeprom the eeprom that shall be written.
+	 * @param journalAddress the page aligned eeprom address of the journal.
+	 */
+	AT24CxTransaction(AT24CxEeprom& eeprom, const uint32_t journalAddress)
+		: AT24CxTransactionBase(eeprom, journalAddress, mHomePageStorage, MaxPages,
+			mPageBufferStorage, PageSize) {
+	}
+
+private:
+	uint16_t mHomePageStorage[MaxPages];
+	uint8_t mPageBufferStorage[PageSize];
+};
+
+#endif /* AT24CxTransaction_HPP_ */
@@ -0,0 +1,122 @@
+/*
+  AT24eeprom - Arduino libary for driving the AT24 I2 based eeproms Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/AT24eeprom/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+#pragma once
+
+#ifndef AT24CxTransport_HPP_
+#define AT24CxTransport_HPP_
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * Access to the I2C bus that an eeprom is connected to. The interface
+ * follows TwoWire, except for reads: requestFrom() takes the word address
+ * as well, so that a backend can send it and read the bytes with a
+ * repeated START in a single bus operation.
+ *
+ * The error codes are those of TwoWire::endTransmission():
+ * 0 success, 2 NACK on the device address, 3 NACK on data, 4 other error.
+ *
+ * Backends: AT24CxTwoWireTransport (Arduino), AT24CxLinuxI2cTransport
+ * (Linux i2c-dev) and AT24CxFakeTransport (eeprom in RAM, for tests).
+ */
+class AT24CxTransport {
+public:
+	/**
+	 * Initialize the bus.
+	 */
+	virtual void begin() = 0;
+
+	/**
+	 * Set the bus clock, if the backend supports it.
+	 * @param clock the clock rate in Hz.
+	 */
+	virtual void setClock(const uint32_t clock) = 0;
+
+	/**
+	 * Start collecting the bytes of a write transfer.
+	 * @param deviceAddress the 7 bit device address.
+	 */
+	virtual void beginTransmission(const uint8_t deviceAddress) = 0;
+
+	/**
+	 * Add a byte to the write transfer.
+	 * @return 1, if the byte has been accepted, 0 if the transfer is full.
+	 */
+	virtual size_t write(const uint8_t byte) = 0;
+
+	/**
+	 * Add bytes to the write transfer.
+	 * @return the number of bytes that have been accepted.
+	 */
+	virtual size_t write(const uint8_t* bytes, const size_t count) = 0;
+
+	/**
+	 * Send the write transfer, terminated by a STOP condition. A transfer
+	 * without bytes probes the device address.
+	 * @return the error code.
+	 */
+	virtual uint8_t endTransmission() = 0;
+
+	/**
+	 * Read bytes. If wordAddressLength is not 0, the word address is sent
+	 * first, otherwise the device continues at its address counter. The
+	 * received bytes are fetched with read().
+	 * @param deviceAddress the 7 bit device address.
+	 * @param wordAddress the word address bytes, most significant first.
+	 * @param count the number of bytes to read, at most maxReadQuantity().
+	 * @param error returns the error code of the word address transfer.
+	 * @return the number of bytes that have been received.
+	 */
+	virtual size_t requestFrom(const uint8_t deviceAddress, const uint8_t* wordAddress,
+		const uint8_t wordAddressLength, const size_t count, uint8_t& error) = 0;
+
+	/**
+	 * get the number of received bytes that have not been fetched yet.
+	 */
+	virtual int available() = 0;
+
+	/**
+	 * Fetch the next received byte.
+	 * @return the byte, or -1 if there is none.
+	 */
+	virtual int read() = 0;
+
+	/**
+	 * get the maximum number of bytes of a write transfer, including the
+	 * word address.
+	 */
+	virtual size_t maxWriteQuantity() const = 0;
+
+	/**
+	 * get the maximum number of bytes of a single requestFrom().
+	 */
+	virtual size_t maxReadQuantity() const = 0;
+
+protected:
+	~AT24CxTransport() {}
+};
+
+#endif /* AT24CxTransport_HPP_ */
@@ -0,0 +1,110 @@
+/*
+  AT24eeprom - Arduino libary for driving the AT24 I2 based eeproms Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/AT24eeprom/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+#if defined(ARDUINO)
+
+#include <stdint.h>
+#include <assert.h>
+#define ASSERT assert
+
+#include <Wire.h>
+
+#include "AT24CxTwoWireTransport.h"
+
+// Fallback for cores that don't tell the size of a buffer.
+#if !(defined BUFFER_LENGTH || defined I2C_BUFFER_LENGTH) || !defined SERIAL_BUFFER_SIZE
+#if defined SIZE_MAX
+static size_t sizeMax() {return SIZE_MAX;}
+#else
+#include <limits>
+static size_t sizeMax() {return std::numeric_limits<size_t>::max();}
+#endif
+#endif
+
+void AT24CxTwoWireTransport::begin() {
+	ASSERT(mWire != nullptr);
+	mWire->begin();
+}
+
+void AT24CxTwoWireTransport::setClock(const uint32_t clock) {
+	mWire->setClock(clock);
+}
+
+void AT24CxTwoWireTransport::beginTransmission(const uint8_t deviceAddress) {
+	mWire->beginTransmission(deviceAddress);
+}
+
+size_t AT24CxTwoWireTransport::write(const uint8_t byte) {
+	return mWire->write(byte);
+}
+
+size_t AT24CxTwoWireTransport::write(const uint8_t* bytes, const size_t count) {
+	return mWire->write(bytes, count);
+}
+
+uint8_t AT24CxTwoWireTransport::endTransmission() {
+	return mWire->endTransmission();
+}
+
+size_t AT24CxTwoWireTransport::requestFrom(const uint8_t deviceAddress, const uint8_t* wordAddress,
+		const uint8_t wordAddressLength, const size_t count, uint8_t& error) {
+	error = 0;
+	if (wordAddressLength > 0) {
+		mWire->beginTransmission(deviceAddress);
+		mWire->write(wordAddress, wordAddressLength);
+		error = mWire->endTransmission();
+		if (error != 0) {
+			return 0;
+		}
+	}
+	return mWire->requestFrom(deviceAddress, count);
+}
+
+int AT24CxTwoWireTransport::available() {
+	return mWire->available();
+}
+
+int AT24CxTwoWireTransport::read() {
+	return mWire->read();
+}
+
+size_t AT24CxTwoWireTransport::maxWriteQuantity() const {
+#if defined BUFFER_LENGTH
+  return static_cast<size_t>(BUFFER_LENGTH);
+#elif defined I2C_BUFFER_LENGTH
+  return static_cast<size_t>(I2C_BUFFER_LENGTH);
+#else
+  return sizeMax();
+#endif
+}
+
+size_t AT24CxTwoWireTransport::maxReadQuantity() const {
+#if defined SERIAL_BUFFER_SIZE
+  return static_cast<size_t>(SERIAL_BUFFER_SIZE);
+#else
+  return sizeMax();
+#endif
+}
+
+#endif
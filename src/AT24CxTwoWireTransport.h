@@ -0,0 +1,66 @@
+/*
+  AT24eeprom - Arduino libary for driving the AT24 I2 based eeproms Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/AT24eeprom/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+#pragma once
+
+#ifndef AT24CxTwoWireTransport_HPP_
+#define AT24CxTwoWireTransport_HPP_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <Wire.h>
+
+#include "AT24CxTransport.h"
+
+/**
+ * Transport over an Arduino TwoWire bus, e.g. Wire. The word address of a
+ * read is sent with a transfer of its own, followed by requestFrom(), as
+ * TwoWire implementations differ in their support for a repeated START.
+ * The buffer limits are taken from the buffer size macros of the core.
+ *
+ * AT24CxEeprom embeds one of these, so sketches simply pass the TwoWire
+ * object to the constructor of the eeprom.
+ */
+class AT24CxTwoWireTransport : public AT24CxTransport {
+public:
+	AT24CxTwoWireTransport(TwoWire* wire) : mWire(wire) {}
+
+	void begin() override;
+	void setClock(const uint32_t clock) override;
+	void beginTransmission(const uint8_t deviceAddress) override;
+	size_t write(const uint8_t byte) override;
+	size_t write(const uint8_t* bytes, const size_t count) override;
+	uint8_t endTransmission() override;
+	size_t requestFrom(const uint8_t deviceAddress, const uint8_t* wordAddress,
+		const uint8_t wordAddressLength, const size_t count, uint8_t& error) override;
+	int available() override;
+	int read() override;
+	size_t maxWriteQuantity() const override;
+	size_t maxReadQuantity() const override;
+
+private:
+	TwoWire* mWire;
+};
+
+#endif /* AT24CxTwoWireTransport_HPP_ */
@@ -0,0 +1,111 @@
+/*
+  AT24eeprom - Arduino libary for driving the AT24 I2 based eeproms Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/AT24eeprom/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#define ASSERT assert
+
+#include "AT24CxVar.h"
+
+#undef min
+static inline size_t min(size_t a, size_t b) {return a < b ? a : b;}
+
+AT24CxVarBase::AT24CxVarBase(AT24CxEeprom& eeprom, const uint32_t address, uint8_t* shadow,
+	uint8_t* changed, const size_t size)
+		: mEeprom(eeprom), mAddress(address), mShadow(shadow), mChanged(changed), mSize(size),
+		  mLoaded(false) {
+	ASSERT(address + size <= eeprom.totalSize());
+}
+
+bool AT24CxVarBase::load() {
+	if (not mEeprom.read(mAddress, mShadow, mSize)) {
+		return false;
+	}
+	memset(mChanged, 0, (mSize + 7) / 8);
+	mLoaded = true;
+	return true;
+}
+
+bool AT24CxVarBase::isDirty() const {
+	for (size_t i = 0; i < (mSize + 7) / 8; i++) {
+		if (mChanged[i] != 0) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void AT24CxVarBase::update(const size_t offset, const void* bytes, const size_t count) {
+	ASSERT(offset + count <= mSize);
+	const uint8_t* const source = static_cast<const uint8_t*>(bytes);
+	for (size_t i = 0; i < count; i++) {
+		if (not mLoaded || mShadow[offset + i] != source[i]) {
+			mShadow[offset + i] = source[i];
+			setChanged(offset + i);
+		}
+	}
+}
+
+bool AT24CxVarBase::commitSpan(const size_t first, const size_t end) {
+	if (mEeprom.write(mAddress + first, &mShadow[first], end - first)) {
+		for (size_t j = first; j < end; j++) {
+			clearChanged(j);
+		}
+		return true;
+	}
+	return false;
+}
+
+bool AT24CxVarBase::commit() {
+	const uint32_t pageSize = mEeprom.pageSize();
+	bool success = true;
+
+	// Walk the pages that the variable covers. Once the shadow is loaded,
+	// the span from the first to the last changed byte of a page is written
+	// with a single page write, otherwise every run of changed bytes.
+	size_t i = 0;
+	while (i < mSize) {
+		const size_t pageEnd = min(mSize, i + (pageSize - ((mAddress + i) & (pageSize - 1))));
+		size_t first = pageEnd;
+		for (size_t j = i; j <= pageEnd; j++) {
+			const bool changed = (j < pageEnd) && isChanged(j);
+			if (changed && first == pageEnd) {
+				first = j;
+			} else if (not changed && first < pageEnd && (not mLoaded || j == pageEnd)) {
+				// Without loaded shadow a run ends at the first unchanged
+				// byte. Otherwise the span ends at the page end and is
+				// trimmed to the last changed byte.
+				size_t end = j;
+				while (mLoaded && not isChanged(end - 1)) {
+					--end;
+				}
+				success = commitSpan(first, end) && success;
+				first = pageEnd;
+			}
+		}
+		i = pageEnd;
+	}
+	return success;
+}
@@ -0,0 +1,242 @@
+/*
+  AT24eeprom - Arduino libary for driving the AT24 I2 based eeproms Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/AT24eeprom/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+#pragma once
+
+#ifndef AT24CxVar_HPP_
+#define AT24CxVar_HPP_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "AT24CxEeprom.h"
+
+/**
+ * Typed variable in the eeprom with a RAM shadow. Changes are made to the
+ * shadow and remember which bytes differ from the eeprom content. commit()
+ * writes them with one write per page, from the first to the last changed
+ * byte of the page. Unchanged pages are not written at all. Until load()
+ * has been called, the shadow is not known to match the eeprom, so only
+ * the bytes that have been set are written.
+ *
+ * The value must be a trivially copyable type, it is stored byte by byte.
+ *
+ * Use the AT24CxVar, AT24CxVarArray and AT24CxVarStruct templates to get a
+ * variable with its own storage.
+ */
+class AT24CxVarBase {
+public:
+	/**
+	 * Read the value from the eeprom into the shadow and discard all changes
+	 * that have not been committed.
+	 * @return true, on success, otherwise false.
+	 */
+	bool load();
+
+	/**
+	 * Write the changed bytes to the eeprom.
+	 * @return true, on success, otherwise false. Bytes of pages that could
+	 * not be written stay changed, so commit() can be called again.
+	 */
+	bool commit();
+
+	/**
+	 * Check whether the shadow has changes that have not been committed.
+	 * @return true, if at least one byte has been changed.
+	 */
+	bool isDirty() const;
+
+	/**
+	 * get the eeprom address of the variable.
+	 */
+	uint32_t address() const {return mAddress;}
+
+	/**
+	 * get the eeprom that holds the variable.
+	 */
+	AT24CxEeprom& eeprom() const {return mEeprom;}
+
+protected:
+	AT24CxVarBase(AT24CxEeprom& eeprom, const uint32_t address, uint8_t* shadow, uint8_t* changed,
+		const size_t size);
+
+	// Copy bytes into the shadow at the offset and mark the bytes that
+	// differ from the shadow as changed. Until the shadow has been loaded,
+	// all copied bytes are marked.
+	void update(const size_t offset, const void* bytes, const size_t count);
+
+private:
+	AT24CxEeprom& mEeprom;
+	const uint32_t mAddress;
+	uint8_t* const mShadow;
+	uint8_t* const mChanged; // one bit per byte of the shadow
+	const size_t mSize;
+	bool mLoaded;
+
+	// Write the changed bytes from first up to end within one page.
+	bool commitSpan(const size_t first, const size_t end);
+
+	inline bool isChanged(const size_t i) const {return (mChanged[i / 8] >> (i % 8)) & 1;}
+	inline void setChanged(const size_t i) {mChanged[i / 8] |= static_cast<uint8_t>(1 << (i % 8));}
+	inline void clearChanged(const size_t i) {mChanged[i / 8] &= static_cast<uint8_t>(~(1 << (i % 8)));}
+};
+
+/**
+ * Places Size bytes at Address of a CHIP, and checks at compile time that
+ * they fit into the eeprom. END is the address behind the last byte, so
+ * that the next variable can be placed there.
+ */
+template<typename CHIP, uint32_t Address, size_t Size>
+class AT24CxVarLayout {
+public:
+	static constexpr uint32_t ADDRESS = Address;
+	static constexpr size_t SIZE = Size;
+	static constexpr uint32_t END = Address + Size;
+
+	static_assert(Size > 0, "A variable needs at least one byte");
+	static_assert(Address < CHIP::TOTAL_SIZE && Size <= CHIP::TOTAL_SIZE - Address,
+		"The variable does not fit into the eeprom");
+};
+
+template<typename CHIP, uint32_t Address, size_t Size>
+constexpr uint32_t AT24CxVarLayout<CHIP, Address, Size>::ADDRESS;
+template<typename CHIP, uint32_t Address, size_t Size>
+constexpr size_t AT24CxVarLayout<CHIP, Address, Size>::SIZE;
+template<typename CHIP, uint32_t Address, size_t Size>
+constexpr uint32_t AT24CxVarLayout<CHIP, Address, Size>::END;
+
+/**
+ * A single value of type T at Address of a CHIP, e.g.
+ * AT24CxVar<AT24C256, 0x100, uint32_t> bootCount(eeprom);
+ */
+template<typename CHIP, uint32_t Address, typename T>
+class AT24CxVar : public AT24CxVarBase, public AT24CxVarLayout<CHIP, Address, sizeof(T)> {
+public:
+	AT24CxVar(CHIP& eeprom)
+		: AT24CxVarBase(eeprom, Address, reinterpret_cast<uint8_t*>(&mValue), mChangedStorage, sizeof(T)),
+		  mValue(), mChangedStorage() {
+	}
+
+	/**
+	 * get the value of the shadow.
+	 */
+	const T& get() const {return mValue;}
+
+	/**
+	 * Set the value of the shadow. It is written by commit().
+	 */
+	void set(const T& value) {update(0, &value, sizeof(T));}
+
+private:
+	T mValue;
+	uint8_t mChangedStorage[(sizeof(T) + 7) / 8];
+};
+
+/**
+ * N values of type T at Address of a CHIP. Only the changed bytes of the
+ * changed elements are written by commit().
+ */
+template<typename CHIP, uint32_t Address, typename T, size_t N>
+class AT24CxVarArray : public AT24CxVarBase, public AT24CxVarLayout<CHIP, Address, N * sizeof(T)> {
+public:
+	static_assert(N > 0, "An array needs at least one element");
+
+	AT24CxVarArray(CHIP& eeprom)
+		: AT24CxVarBase(eeprom, Address, reinterpret_cast<uint8_t*>(mValues), mChangedStorage, N * sizeof(T)),
+		  mValues(), mChangedStorage() {
+	}
+
+	/**
+	 * get the number of elements.
+	 */
+	static constexpr size_t size() {return N;}
+
+	/**
+	 * get an element of the shadow.
+	 */
+	const T& get(const size_t index) const {return mValues[index];}
+
+	/**
+	 * Set an element of the shadow. It is written by commit().
+	 */
+	void set(const size_t index, const T& value) {update(index * sizeof(T), &value, sizeof(T));}
+
+private:
+	T mValues[N];
+	uint8_t mChangedStorage[(N * sizeof(T) + 7) / 8];
+};
+
+// Takes the type of a field from the member pointer only, so that e.g. an
+// int literal can be assigned to a uint32_t field.
+template<typename F>
+struct AT24CxVarField {
+	typedef F type;
+};
+
+/**
+ * A struct of type Layout at Address of a CHIP. Fields are set one by one,
+ * e.g. settings.set(&Settings::baudRate, 115200), and only their changed
+ * bytes are written by commit().
+ */
+template<typename CHIP, uint32_t Address, typename Layout>
+class AT24CxVarStruct : public AT24CxVarBase, public AT24CxVarLayout<CHIP, Address, sizeof(Layout)> {
+public:
+	AT24CxVarStruct(CHIP& eeprom)
+		: AT24CxVarBase(eeprom, Address, reinterpret_cast<uint8_t*>(&mValue), mChangedStorage, sizeof(Layout)),
+		  mValue(), mChangedStorage() {
+	}
+
+	/**
+	 * get the whole struct of the shadow.
+	 */
+	const Layout& get() const {return mValue;}
+
+	/**
+	 * get a field of the shadow.
+	 */
+	template<typename F>
+	const F& get(F Layout::* field) const {return mValue.*field;}
+
+	/**
+	 * Set the whole struct of the shadow. Only the bytes that differ are
+	 * written by commit().
+	 */
+	void set(const Layout& value) {update(0, &value, sizeof(Layout));}
+
+	/**
+	 * Set a field of the shadow. It is written by commit().
+	 */
+	template<typename F>
+	void set(F Layout::* field, const typename AT24CxVarField<F>::type& value) {
+		const size_t offset = reinterpret_cast<const uint8_t*>(&(mValue.*field))
+			- reinterpret_cast<const uint8_t*>(&mValue);
+		update(offset, &value, sizeof(F));
+	}
+
+private:
+	Layout mValue;
+	uint8_t mChangedStorage[(sizeof(Layout) + 7) / 8];
+};
+
+#endif /* AT24CxVar_HPP_ */
@@ -0,0 +1,191 @@
+/*
+  AT24eeprom - Arduino libary for driving the AT24 I2 based eeproms Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/AT24eeprom/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#define ASSERT assert
+
+#include "AT24CxPlatform.h"
+
+#include "AT24CxWearLevelingRecord.h"
+#include "AT24CxCrc.h"
+
+using AT24CxCrc::CRC16_INIT;
+using AT24CxCrc::crc16;
+
+namespace { // anonymous
+
+// Serial number arithmetic, so that the sequence number may wrap around.
+inline bool isNewer(const uint32_t sequence, const uint32_t reference) {
+	return static_cast<int32_t>(sequence - reference) > 0;
+}
+
+// Round the slot up to a divisor or a multiple of the page size, so that
+// slots don't straddle pages.
+uint16_t alignedSlotSize(const uint16_t size, const uint16_t pageSize) {
+	if (size >= pageSize) {
+		return static_cast<uint16_t>((size + pageSize - 1) / pageSize * pageSize);
+	}
+	uint16_t aligned = 1;
+	while (aligned < size) {
+		aligned <<= 1;
+	}
+	return aligned;
+}
+
+// Walks through the slots while the region is read, and finds the slot with
+// the newest valid record.
+class ScanSink : public AT24CxEeprom::ReadSink {
+public:
+	ScanSink(const uint16_t recordSize, const uint16_t slotSize, const uint16_t slotCount)
+		: mRecordSize(recordSize), mSlotSize(slotSize), mSlotCount(slotCount), mSlot(0), mOffset(0),
+		  mCrc(CRC16_INIT), mSequence(0), mStoredCrc(0), mNewestSlot(slotCount), mNewestSequence(0) {
+	}
+
+	void receive(const uint8_t byte) override {
+		if (mSlot >= mSlotCount) {
+			return;
+		}
+
+		const uint16_t sequenceEnd = mRecordSize + sizeof(uint32_t);
+		const uint16_t trailerEnd = sequenceEnd + sizeof(uint16_t);
+		if (mOffset < sequenceEnd) {
+			mCrc = crc16(mCrc, byte);
+			if (mOffset >= mRecordSize) {
+				mSequence |= static_cast<uint32_t>(byte) << (8 * (mOffset - mRecordSize));
+			}
+		} else if (mOffset < trailerEnd) {
+			mStoredCrc |= static_cast<uint16_t>(byte) << (8 * (mOffset - sequenceEnd));
+		}
+
+		// The padding up to the end of the slot is skipped.
+		if (++mOffset == trailerEnd) {
+			if (mCrc == mStoredCrc
+					&& (mNewestSlot == mSlotCount || isNewer(mSequence, mNewestSequence))) {
+				mNewestSlot = mSlot;
+				mNewestSequence = mSequence;
+			}
+		}
+		if (mOffset == mSlotSize) {
+			++mSlot;
+			mOffset = 0;
+			mCrc = CRC16_INIT;
+			mSequence = 0;
+			mStoredCrc = 0;
+		}
+	}
+
+	uint16_t newestSlot() const {return mNewestSlot;}
+	uint32_t newestSequence() const {return mNewestSequence;}
+
+private:
+	const uint16_t mRecordSize;
+	const uint16_t mSlotSize;
+	const uint16_t mSlotCount;
+	uint16_t mSlot;
+	uint16_t mOffset;
+	uint16_t mCrc;
+	uint32_t mSequence;
+	uint16_t mStoredCrc;
+	uint16_t mNewestSlot;
+	uint32_t mNewestSequence;
+};
+
+} // anonymous namespace
+
+constexpr uint16_t AT24CxWearLevelingRecordBase::TRAILER_SIZE;
+
+AT24CxWearLevelingRecordBase::AT24CxWearLevelingRecordBase(AT24CxEeprom& eeprom, const uint32_t regionAddress,
+	const uint16_t regionSize, const uint16_t recordSize, uint8_t* slot)
+		: mEeprom(eeprom), mSlot(slot), mRegionAddress(regionAddress), mRecordSize(recordSize),
+		  mSlotSize(alignedSlotSize(recordSize + TRAILER_SIZE, eeprom.pageSize())),
+		  mSlotCount(regionSize / mSlotSize), mNewestSlot(mSlotCount), mSequence(0),
+		  mBegun(false) {
+	ASSERT(mSlotCount > 0);
+	ASSERT((regionAddress & (eeprom.pageSize() - 1)) == 0);
+	ASSERT(regionAddress + regionSize <= eeprom.totalSize());
+}
+
+bool AT24CxWearLevelingRecordBase::begin() {
+	// The region is read page by page, the slots are checked on the fly. The
+	// cursor continues each read at the address counter of the eeprom.
+	ScanSink scan(mRecordSize, mSlotSize, mSlotCount);
+	AT24CxEeprom::ReadCursor cursor(mEeprom, mRegionAddress);
+	const uint32_t scanSize = static_cast<uint32_t>(mSlotCount) * mSlotSize;
+	for (uint32_t offset = 0; offset < scanSize; offset += mEeprom.pageSize()) {
+		const uint32_t remaining = scanSize - offset;
+		const size_t count = (remaining < mEeprom.pageSize()) ? remaining : mEeprom.pageSize();
+		if (not cursor.read(scan, count)) {
+			return false;
+		}
+	}
+	mNewestSlot = scan.newestSlot();
+	mSequence = scan.newestSequence();
+	mBegun = true;
+	return true;
+}
+
+bool AT24CxWearLevelingRecordBase::load(void* record) {
+	if (not mBegun && not begin()) {
+		return false;
+	}
+	if (not hasRecord()) {
+		return false;
+	}
+	return mEeprom.read(slotAddress(mNewestSlot), static_cast<uint8_t*>(record), mRecordSize);
+}
+
+bool AT24CxWearLevelingRecordBase::store(const void* record) {
+	if (not mBegun && not begin()) {
+		return false;
+	}
+
+	const uint16_t slot = hasRecord() ? (mNewestSlot + 1) % mSlotCount : 0;
+	const uint32_t sequence = hasRecord() ? mSequence + 1 : 0;
+
+	memcpy(mSlot, record, mRecordSize);
+	uint8_t* const trailer = &mSlot[mRecordSize];
+	for (uint8_t i = 0; i < sizeof(uint32_t); i++) {
+		trailer[i] = static_cast<uint8_t>(sequence >> (8 * i));
+	}
+	const uint16_t crc = crc16(CRC16_INIT, mSlot, mRecordSize + sizeof(uint32_t));
+	trailer[sizeof(uint32_t)] = lowByte(crc);
+	trailer[sizeof(uint32_t) + 1] = highByte(crc);
+
+	// Record and trailer go to the eeprom with a single write, within a page
+	// unless the record is larger. The CRC covers both, so a torn write is
+	// detected without ordering the writes.
+	if (not mEeprom.write(slotAddress(slot), mSlot, mRecordSize + TRAILER_SIZE)) {
+		// The slot is in an undefined state now. The previous record remains
+		// the newest valid one, the region is scanned again on next access.
+		mBegun = false;
+		return false;
+	}
+
+	mNewestSlot = slot;
+	mSequence = sequence;
+	return true;
+}
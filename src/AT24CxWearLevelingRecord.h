@@ -0,0 +1,148 @@
+/*
+  AT24eeprom - Arduino libary for driving the AT24 I2 based eeproms Copyright (c)
+  2025 Wolfgang Schmieder.  All right reserved.
+
+  Contributors:
+  - Wolfgang Schmieder
+
+  Project home: https://github.com/dac1e/AT24eeprom/
+
+  This library is free software; you can redistribute it and/or modify it
+  the terms of the GNU Lesser General Public License as under published
+  by the Free Software Foundation; either version 3.0 of the License,
+  or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+
+#pragma once
+
+#ifndef AT24CxWearLevelingRecord_HPP_
+#define AT24CxWearLevelingRecord_HPP_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "AT24CxEeprom.h"
+
+/**
+ * A fixed size record that is stored in a rotating set of slots within an
+ * eeprom region, so that frequent updates are spread evenly over the region
+ * instead of wearing out the same cells.
+ *
+ * Each slot holds the record, followed by a sequence number and a CRC-16
+ * over both. store() writes the next slot with an incremented sequence
+ * number, record and trailer with a single write. A write that is
+ * interrupted by a power loss fails the CRC, so the previous record remains
+ * the newest valid one.
+ *
+ * The slots are page aligned: a slot that is smaller than a page is rounded
+ * up to the next power of 2, so that it never straddles two pages, and a
+ * larger one is rounded up to whole pages.
+ *
+ * Use the AT24CxWearLevelingRecord template to get a record with its own
+ * slot buffer.
+ */
+class AT24CxWearLevelingRecordBase {
+public:
+	/**
+	 * Find the newest valid record by reading the region once, page by page.
+	 * Called by load() and store() if it has not been called before.
+	 * @return true, on success, otherwise false.
+	 */
+	bool begin();
+
+	/**
+	 * Load the newest valid record.
+	 * @param record the location where the record shall be returned.
+	 * @return true, if a valid record has been loaded, otherwise false.
+	 */
+	bool load(void* record);
+
+	/**
+	 * Store a record into the next slot.
+	 * @param record the record that shall be stored.
+	 * @return true, on success, otherwise false.
+	 */
+	bool store(const void* record);
+
+	/**
+	 * get the number of slots the region provides.
+	 */
+	uint16_t slotCount() const {return mSlotCount;}
+
+	/**
+	 * get the size of a slot, including the padding up to the page aligned size.
+	 */
+	uint16_t slotSize() const {return mSlotSize;}
+
+	/**
+	 * get the sequence number of the newest valid record. It is incremented
+	 * with every store().
+	 */
+	uint32_t sequence() const {return mSequence;}
+
+	/**
+	 * Check whether the region holds a valid record.
+	 */
+	bool hasRecord() const {return mNewestSlot < mSlotCount;}
+
+	// Size of the sequence number and the crc that follow the record.
+	static constexpr uint16_t TRAILER_SIZE = sizeof(uint32_t) + sizeof(uint16_t);
+
+protected:
+	/**
+	 * @param eeprom the eeprom that holds the region.
+	 * @param regionAddress eeprom address of the region, page aligned.
+	 * @param regionSize the size of the region in bytes.
+	 * @param recordSize the size of the record in bytes.
+	 * @param slot buffer of recordSize + TRAILER_SIZE bytes.
+	 */
+	AT24CxWearLevelingRecordBase(AT24CxEeprom& eeprom, const uint32_t regionAddress,
+		const uint16_t regionSize, const uint16_t recordSize, uint8_t* slot);
+
+private:
+	AT24CxEeprom& mEeprom;
+	uint8_t* const mSlot;
+	const uint32_t mRegionAddress;
+	const uint16_t mRecordSize;
+	const uint16_t mSlotSize;
+	const uint16_t mSlotCount;
+	uint16_t mNewestSlot; // mSlotCount if there is no valid record
+	uint32_t mSequence;
+	bool mBegun;
+
+	inline uint32_t slotAddress(const uint16_t slot) const {
+		return mRegionAddress + static_cast<uint32_t>(slot) * mSlotSize;
+	}
+};
+
+/**
+ * Wear leveled record of RecordSize bytes, e.g.
+ * AT24CxWearLevelingRecord<sizeof(Counters)> record(eeprom, 0x7C00, 0x400);
+ */
+template<uint16_t RecordSize>
+class AT24CxWearLevelingRecord : public AT24CxWearLevelingRecordBase {
+public:
+	/**
+	 * @param eeprom the eeprom that holds the region.
+	 * @param regionAddress eeprom address of the region, page aligned.
+	 * @param regionSize the size of the region in bytes.
+	 */
+	AT24CxWearLevelingRecord(AT24CxEeprom& eeprom, const uint32_t regionAddress, const uint16_t regionSize)
+		: AT24CxWearLevelingRecordBase(eeprom, regionAddress, regionSize, RecordSize, mSlotStorage) {
+	}
+
+private:
+	uint8_t mSlotStorage[RecordSize + TRAILER_SIZE];
+};
+
+#endif /* AT24CxWearLevelingRecord_HPP_ */
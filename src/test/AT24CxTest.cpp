@@ -148,6 +148,87 @@ void Test::test_pageOperations() {
 	UTS_END();
 }
 
+void Test::test_asyncOperations() {
+	UTS_BEGIN();
+
+	const size_t bytesCount = 2*mEeprom->pageSize() + 1;
+	uint8_t* writeBuffer = new uint8_t [bytesCount];
+	fillBuffer(writeBuffer, bytesCount, 0x66);
+	writeBuffer[0] = ~writeBuffer[0];
+	writeBuffer[bytesCount-1] = ~writeBuffer[bytesCount-1];
+
+	// Starts on the first page and ends on the 3rd page.
+	const uint16_t address = mEeprom->pageSize() - 1;
+	utsAssert(mEeprom->beginWrite(address, writeBuffer, bytesCount));
+	utsAssert(mEeprom->isBusy());
+	utsAssert(not mEeprom->beginWrite(address, writeBuffer, bytesCount));
+	while(mEeprom->isBusy()) {
+		mEeprom->tick();
+	}
+
+	uint8_t* readBuffer = new uint8_t [bytesCount];
+	mEeprom->read(address, readBuffer, bytesCount);
+	utsAssert(memcmp(readBuffer, writeBuffer, bytesCount) == 0);
+
+	delete[] readBuffer;
+	delete[] writeBuffer;
+
+	UTS_END();
+}
+
+void Test::test_writeIfChanged() {
+	UTS_BEGIN();
+
+	const size_t bytesCount = 2*mEeprom->pageSize();
+	uint8_t* writeBuffer = new uint8_t [bytesCount];
+	fillBuffer(writeBuffer, bytesCount, 0x77);
+
+	// Starts on the 2nd page and ends on the 4th page.
+	const uint16_t address = mEeprom->pageSize() + 1;
+	size_t pagesWritten = 0;
+	utsAssert(mEeprom->writeIfChanged(address, writeBuffer, bytesCount, pagesWritten));
+
+	// Nothing changed
+	utsAssert(mEeprom->writeIfChanged(address, writeBuffer, bytesCount, pagesWritten));
+	utsAssert(pagesWritten == 0);
+
+	// Two bytes on the 3rd page changed
+	writeBuffer[mEeprom->pageSize()] = 0x78;
+	writeBuffer[mEeprom->pageSize() + 2] = 0x79;
+	utsAssert(mEeprom->writeIfChanged(address, writeBuffer, bytesCount, pagesWritten));
+	utsAssert(pagesWritten == 1);
+
+	uint8_t* readBuffer = new uint8_t [bytesCount];
+	mEeprom->read(address, readBuffer, bytesCount);
+	utsAssert(memcmp(readBuffer, writeBuffer, bytesCount) == 0);
+
+	delete[] readBuffer;
+	delete[] writeBuffer;
+
+	UTS_END();
+}
+
+void Test::test_expectedWriteCycles() {
+	UTS_BEGIN();
+
+	const uint16_t pageSize = mEeprom->pageSize();
+
+	utsAssert(mEeprom->expectedWriteCycles(0, 0) == 0);
+	utsAssert(mEeprom->expectedWriteCycles(1, 1) == 1);
+
+	// Crossing a page boundary costs at least one more write cycle.
+	utsAssert(mEeprom->expectedWriteCycles(pageSize - 1, 2) == 2);
+
+	// One more byte on the next page costs exactly one more write cycle, and
+	// N full pages cost N times as many write cycles as a single full page.
+	const size_t fullPage = mEeprom->expectedWriteCycles(0, pageSize);
+	utsAssert(fullPage >= 1);
+	utsAssert(mEeprom->expectedWriteCycles(0, pageSize + 1) == fullPage + 1);
+	utsAssert(mEeprom->expectedWriteCycles(0, 4 * pageSize) == 4 * fullPage);
+
+	UTS_END();
+}
+
 } // namespace At24C256test
 
 #endif // AT24CxEepromEnableTest
@@ -41,6 +41,9 @@ public:
     instance.setup();
     instance.test_byteOperations();
     instance.test_pageOperations();
+    instance.test_asyncOperations();
+    instance.test_writeIfChanged();
+    instance.test_expectedWriteCycles();
     instance.mEeprom = nullptr;
   }
 
@@ -58,6 +61,9 @@ private:
 	void setup();
 	void test_pageOperations();
 	void test_byteOperations();
+	void test_asyncOperations();
+	void test_writeIfChanged();
+	void test_expectedWriteCycles();
 	bool writeReadAndCompare(size_t bytesCount, uint8_t pattern, uint16_t address);
 
   Print& mTestLogOutput;